@@ -56,6 +56,9 @@ int VoidEngine::Exec(int argc, char** argv)
     QGuiApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
     #endif
 
+    /* Offscreen renderers draw with the textures (e.g. font atlases) created by the viewer's context */
+    QGuiApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
+
     QApplication app(argc, argv);
 
     Setup(app);
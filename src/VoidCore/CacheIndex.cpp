@@ -0,0 +1,241 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+/* STD */
+#include <iterator>
+
+/* Internal */
+#include "CacheIndex.h"
+
+VOID_NAMESPACE_OPEN
+
+/* Frame Bitmap {{{ */
+
+FrameBitmap::FrameBitmap()
+    : m_Words(nullptr)
+    , m_Capacity(0)
+    , m_Size(0)
+    , m_Start(0)
+    , m_Count(0)
+{
+}
+
+void FrameBitmap::Reset(v_frame_t start, v_frame_t end)
+{
+    m_Start = start;
+    m_Size = end >= start ? static_cast<std::size_t>(end - start) + 1 : 0;
+
+    const std::size_t words = (m_Size + 63) / 64;
+
+    /* Only grow the words when the range can't be represented with what we already have */
+    if (words > m_Capacity)
+    {
+        m_Words.reset(new std::atomic<uint64_t>[words]);
+        m_Capacity = words;
+    }
+
+    Clear();
+}
+
+void FrameBitmap::Clear()
+{
+    for (std::size_t i = 0; i < m_Capacity; ++i)
+        m_Words[i].store(0, std::memory_order_relaxed);
+
+    m_Count.store(0, std::memory_order_release);
+}
+
+bool FrameBitmap::Set(v_frame_t frame)
+{
+    if (!InRange(frame))
+        return false;
+
+    const std::size_t offset = static_cast<std::size_t>(frame - m_Start);
+    const uint64_t mask = uint64_t(1) << (offset & 63);
+
+    /* The bit was already set, nothing changes */
+    if (m_Words[offset >> 6].fetch_or(mask, std::memory_order_acq_rel) & mask)
+        return false;
+
+    m_Count.fetch_add(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool FrameBitmap::Unset(v_frame_t frame)
+{
+    if (!InRange(frame))
+        return false;
+
+    const std::size_t offset = static_cast<std::size_t>(frame - m_Start);
+    const uint64_t mask = uint64_t(1) << (offset & 63);
+
+    /* The bit was not set, nothing changes */
+    if (!(m_Words[offset >> 6].fetch_and(~mask, std::memory_order_acq_rel) & mask))
+        return false;
+
+    m_Count.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool FrameBitmap::Test(v_frame_t frame) const
+{
+    if (!InRange(frame))
+        return false;
+
+    const std::size_t offset = static_cast<std::size_t>(frame - m_Start);
+    return m_Words[offset >> 6].load(std::memory_order_acquire) & (uint64_t(1) << (offset & 63));
+}
+
+/* }}} */
+
+/* Frame Ring {{{ */
+
+FrameRing::FrameRing()
+    : m_Head(0)
+    , m_Size(0)
+{
+}
+
+void FrameRing::Reset(std::size_t capacity)
+{
+    /* Resize only grows or shrinks the frames, the allocation is kept for the next media */
+    m_Frames.resize(capacity);
+    Clear();
+}
+
+bool FrameRing::PushBack(v_frame_t frame)
+{
+    if (Full())
+        return false;
+
+    m_Frames[Index(m_Size)] = frame;
+    ++m_Size;
+    return true;
+}
+
+bool FrameRing::PushFront(v_frame_t frame)
+{
+    if (Full())
+        return false;
+
+    m_Head = m_Head == 0 ? m_Frames.size() - 1 : m_Head - 1;
+    m_Frames[m_Head] = frame;
+    ++m_Size;
+    return true;
+}
+
+v_frame_t FrameRing::PopFront()
+{
+    v_frame_t frame = m_Frames[m_Head];
+
+    m_Head = Index(1);
+    --m_Size;
+
+    return frame;
+}
+
+v_frame_t FrameRing::PopBack()
+{
+    v_frame_t frame = Back();
+    --m_Size;
+
+    return frame;
+}
+
+/* }}} */
+
+/* Frame Spans {{{ */
+
+FrameSpans::SpanMap::const_iterator FrameSpans::Find(v_frame_t frame) const
+{
+    /* The span that starts after the frame, the one just before it is the only one which could hold the frame */
+    SpanMap::const_iterator it = m_Spans.upper_bound(frame);
+
+    if (it == m_Spans.begin())
+        return m_Spans.end();
+
+    --it;
+    return frame <= it->second ? it : m_Spans.end();
+}
+
+void FrameSpans::Add(v_frame_t frame)
+{
+    SpanMap::iterator next = m_Spans.upper_bound(frame);
+
+    if (next != m_Spans.begin())
+    {
+        SpanMap::iterator prev = std::prev(next);
+
+        /* Already a part of the span */
+        if (frame <= prev->second)
+            return;
+
+        /* Extends the previous span */
+        if (prev->second + 1 == frame)
+        {
+            prev->second = frame;
+
+            /* And now bridges over to the next span */
+            if (next != m_Spans.end() && next->first == frame + 1)
+            {
+                prev->second = next->second;
+                m_Spans.erase(next);
+            }
+
+            return;
+        }
+    }
+
+    /* Extends the next span backwards */
+    if (next != m_Spans.end() && next->first == frame + 1)
+    {
+        v_frame_t end = next->second;
+        m_Spans.erase(next);
+        m_Spans.emplace(frame, end);
+        return;
+    }
+
+    /* A span of its own */
+    m_Spans.emplace(frame, frame);
+}
+
+void FrameSpans::Remove(v_frame_t frame)
+{
+    SpanMap::iterator it = m_Spans.upper_bound(frame);
+
+    if (it == m_Spans.begin())
+        return;
+
+    --it;
+
+    /* Not a part of any span */
+    if (frame > it->second)
+        return;
+
+    const v_frame_t start = it->first;
+    const v_frame_t end = it->second;
+
+    m_Spans.erase(it);
+
+    /* Whatever is left on either side of the frame remains as spans */
+    if (start < frame)
+        m_Spans.emplace(start, frame - 1);
+
+    if (frame < end)
+        m_Spans.emplace(frame + 1, end);
+}
+
+bool FrameSpans::Contains(v_frame_t frame) const
+{
+    return Find(frame) != m_Spans.end();
+}
+
+bool FrameSpans::Contains(v_frame_t start, v_frame_t end) const
+{
+    SpanMap::const_iterator it = Find(start);
+    return it != m_Spans.end() && end <= it->second;
+}
+
+/* }}} */
+
+VOID_NAMESPACE_CLOSE
@@ -0,0 +1,195 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#ifndef _VOID_CACHE_INDEX_H
+#define _VOID_CACHE_INDEX_H
+
+/* STD */
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+/* Internal */
+#include "Definition.h"
+
+VOID_NAMESPACE_OPEN
+
+/**
+ * @brief A Bitmap of frames, indexed by the offset of the frame from the start of the range.
+ *
+ * Each frame in the range takes a single bit, so marking, unmarking and testing for a frame are
+ * constant time operations. The words are atomic which allows cache threads to mark frames without
+ * having to lock the whole structure, while the main thread checks for frames being available.
+ *
+ * The count of marked frames is kept alongside which allows checking if the whole range has been
+ * marked without iterating over the bits.
+ */
+class VOID_API FrameBitmap
+{
+public:
+    FrameBitmap();
+
+    /**
+     * @brief Resets the bitmap to represent the given range (inclusive), all frames are unmarked.
+     * Memory is only reallocated if the range needs more words than already allocated.
+     */
+    void Reset(v_frame_t start, v_frame_t end);
+
+    /**
+     * @brief Unmarks all frames in the current range.
+     */
+    void Clear();
+
+    /**
+     * @brief Marks the frame.
+     *
+     * @return true if the frame was not marked before this call.
+     * @return false if the frame was already marked or is out of range.
+     */
+    bool Set(v_frame_t frame);
+
+    /**
+     * @brief Unmarks the frame.
+     *
+     * @return true if the frame was marked before this call.
+     * @return false if the frame was not marked or is out of range.
+     */
+    bool Unset(v_frame_t frame);
+
+    /**
+     * @brief Returns whether the frame has been marked.
+     */
+    bool Test(v_frame_t frame) const;
+
+    [[nodiscard]] inline bool InRange(v_frame_t frame) const
+    {
+        return frame >= m_Start && frame < m_Start + static_cast<v_frame_t>(m_Size);
+    }
+
+    inline std::size_t Count() const { return m_Count.load(std::memory_order_acquire); }
+    inline std::size_t Size() const { return m_Size; }
+    [[nodiscard]] inline bool Full() const { return m_Size && Count() >= m_Size; }
+
+private: /* Members */
+    std::unique_ptr<std::atomic<uint64_t>[]> m_Words;
+    std::size_t m_Capacity;
+    std::size_t m_Size;
+    v_frame_t m_Start;
+
+    std::atomic<std::size_t> m_Count;
+};
+
+/**
+ * @brief A fixed capacity ring of frames, this holds the order in which the frames were requested
+ * to be cached so that the frames at either end can be evicted when the memory limit is reached.
+ *
+ * Pushing and popping from both ends are constant time and do not allocate.
+ * The capacity is expected to be atleast the duration of the range being cached.
+ */
+class VOID_API FrameRing
+{
+public:
+    FrameRing();
+
+    /**
+     * @brief Resets the ring to hold atmost capacity frames, the ring is emptied.
+     */
+    void Reset(std::size_t capacity);
+    inline void Clear() { m_Head = 0; m_Size = 0; }
+
+    /**
+     * Adds the frame at either end of the ring, returns false if the ring is already full
+     */
+    bool PushBack(v_frame_t frame);
+    bool PushFront(v_frame_t frame);
+
+    /**
+     * Removes and returns the frame from either end of the ring
+     * The ring is expected to have atleast one frame
+     */
+    v_frame_t PopFront();
+    v_frame_t PopBack();
+
+    inline v_frame_t Front() const { return m_Frames[m_Head]; }
+    inline v_frame_t Back() const { return m_Frames[Index(m_Size - 1)]; }
+
+    inline std::size_t Size() const { return m_Size; }
+    inline std::size_t Capacity() const { return m_Frames.size(); }
+    [[nodiscard]] inline bool Empty() const { return m_Size == 0; }
+    [[nodiscard]] inline bool Full() const { return m_Size >= m_Frames.size(); }
+
+private: /* Members */
+    std::vector<v_frame_t> m_Frames;
+    std::size_t m_Head;
+    std::size_t m_Size;
+
+private: /* Methods */
+    inline std::size_t Index(std::size_t offset) const
+    {
+        std::size_t index = m_Head + offset;
+        return index >= m_Frames.size() ? index - m_Frames.size() : index;
+    }
+};
+
+/**
+ * @brief A run length encoded set of frames.
+ *
+ * Frames which are next to each other are merged into a single span, this keeps the structure small
+ * for a large range of cached frames e.g. 50k frames cached from start to end is just a single span
+ * and allows anything which needs to represent the frames (like the timeline) to do so per span
+ * instead of per frame.
+ */
+class VOID_API FrameSpans
+{
+public:
+    /* Start frame mapped to the end frame (inclusive) of the span */
+    typedef std::map<v_frame_t, v_frame_t> SpanMap;
+    typedef SpanMap::const_iterator const_iterator;
+
+public:
+    /**
+     * @brief Adds a frame to the set, merging with any span before or after it.
+     */
+    void Add(v_frame_t frame);
+
+    /**
+     * @brief Removes a frame from the set, splitting the span it belongs to if needed.
+     */
+    void Remove(v_frame_t frame);
+
+    inline void Clear() { m_Spans.clear(); }
+
+    /**
+     * @brief Returns whether the frame is present in the set.
+     */
+    bool Contains(v_frame_t frame) const;
+
+    /**
+     * @brief Returns whether all frames between start and end (inclusive) are present in the set.
+     */
+    bool Contains(v_frame_t start, v_frame_t end) const;
+
+    /**
+     * Number of spans (not the frames) in the set
+     */
+    inline std::size_t Size() const { return m_Spans.size(); }
+    [[nodiscard]] inline bool Empty() const { return m_Spans.empty(); }
+
+    inline const_iterator begin() const { return m_Spans.cbegin(); }
+    inline const_iterator end() const { return m_Spans.cend(); }
+
+private: /* Members */
+    SpanMap m_Spans;
+
+private: /* Methods */
+    /**
+     * Returns the iterator to the span which holds the frame, end() if the frame is not present
+     */
+    SpanMap::const_iterator Find(v_frame_t frame) const;
+};
+
+VOID_NAMESPACE_CLOSE
+
+#endif // _VOID_CACHE_INDEX_H
@@ -1,14 +1,22 @@
 // Copyright (c) 2025 waaake
 // Licensed under the MIT License
 
+/* STD */
+#include <algorithm>
+#include <cstddef>
+
 /* Internal */
 #include "ColorProcessor.h"
 #include "Logging.h"
+#include "TaskScheduler.h"
 
 namespace OCIO = OCIO_NAMESPACE;
 
 VOID_NAMESPACE_OPEN
 
+/* Size of a band of rows converted on a thread */
+static const std::size_t s_TileSize = 256 * 1024;
+
 ColorProcessor::ColorProcessor()
 {
     /* Initiate with a Builtin Config */
@@ -24,25 +32,19 @@ ColorProcessor& ColorProcessor::Instance()
 void ColorProcessor::SetConfig(const Config& type)
 {
     if (type == Config::Builtin)
-        m_Config = OCIO::Config::CreateFromBuiltinConfig("cg-config-v1.0.0_aces-v1.3_ocio-v2.1");
+        SwapConfig(OCIO::Config::CreateFromBuiltinConfig("cg-config-v1.0.0_aces-v1.3_ocio-v2.1"));
     else
-        m_Config = OCIO::Config::CreateFromEnv();
-
-    OCIO::SetCurrentConfig(m_Config);
+        SwapConfig(OCIO::Config::CreateFromEnv());
 }
 
 void ColorProcessor::SetConfig(const std::string& path)
 {
-    m_Config = OCIO::Config::CreateFromFile(path.c_str());
-
-    OCIO::SetCurrentConfig(m_Config);
+    SwapConfig(OCIO::Config::CreateFromFile(path.c_str()));
 }
 
 void ColorProcessor::SetConfig(std::istream& stream)
 {
-    m_Config = OCIO::Config::CreateFromStream(stream);
-
-    OCIO::SetCurrentConfig(m_Config);
+    SwapConfig(OCIO::Config::CreateFromStream(stream));
 }
 
 std::vector<std::string> ColorProcessor::Displays() const
@@ -152,34 +154,96 @@ std::string ColorProcessor::Shader(const std::string& function) const
     return shaderDesc->getShaderText();
 }
 
-void ColorProcessor::ProcessImage(float* pixels, int width, int height, int channels, const std::string& outcolorspace) const
+void ColorProcessor::ProcessImage(
+    float* pixels,
+    int width,
+    int height,
+    int channels,
+    const std::string& outcolorspace,
+    const Optimization& optimization
+) const
 {
-    OCIO::ConstProcessorRcPtr processor = processor = m_Config->getProcessor(OCIO::ROLE_SCENE_LINEAR, outcolorspace.c_str());
-    OCIO::ConstCPUProcessorRcPtr cpuproc = processor->getDefaultCPUProcessor();
-
-    OCIO::PackedImageDesc imgdesc(pixels, width, height, channels);
-    cpuproc->apply(imgdesc);
+    Apply(CPUProcessor(OCIO::ROLE_SCENE_LINEAR, outcolorspace, optimization), pixels, width, height, channels);
 }
 
-void ColorProcessor::ProcessImage(float* pixels, int width, int height, int channels, const ColorSpace& colorspace, const std::string& outcolorspace) const
+void ColorProcessor::ProcessImage(
+    float* pixels,
+    int width,
+    int height,
+    int channels,
+    const ColorSpace& colorspace,
+    const std::string& outcolorspace,
+    const Optimization& optimization
+) const
 {
-    OCIO::ConstProcessorRcPtr processor = nullptr;
+    std::string source;
     switch (colorspace)
     {
         case ColorSpace::Linear:
-            processor = m_Config->getProcessor(OCIO::ROLE_SCENE_LINEAR, outcolorspace.c_str());
+            source = OCIO::ROLE_SCENE_LINEAR;
             break;
         case ColorSpace::sRGB:
-            processor = m_Config->getProcessor("None", outcolorspace.c_str());
+            source = "None";
             break;
         default:
-            processor = m_Config->getProcessor(OCIO::ROLE_DEFAULT, outcolorspace.c_str());
+            source = OCIO::ROLE_DEFAULT;
     }
 
-    OCIO::ConstCPUProcessorRcPtr cpuproc = processor->getDefaultCPUProcessor();
+    Apply(CPUProcessor(source, outcolorspace, optimization), pixels, width, height, channels);
+}
+
+OCIO::ConstCPUProcessorRcPtr ColorProcessor::CPUProcessor(const std::string& source, const std::string& destination, const Optimization& optimization) const
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    ProcessorKey key(source, destination, optimization);
+    auto it = m_CProcessors.find(key);
+
+    if (it != m_CProcessors.end())
+        return it->second;
+
+    OCIO::ConstProcessorRcPtr processor = m_Config->getProcessor(source.c_str(), destination.c_str());
+    OCIO::ConstCPUProcessorRcPtr cpuproc = processor->getOptimizedCPUProcessor(
+        optimization == Optimization::Interactive ? OCIO::OPTIMIZATION_DRAFT : OCIO::OPTIMIZATION_DEFAULT
+    );
+
+    m_CProcessors[key] = cpuproc;
+    return cpuproc;
+}
+
+void ColorProcessor::Apply(const OCIO::ConstCPUProcessorRcPtr& processor, float* pixels, int width, int height, int channels) const
+{
+    if (width <= 0 || height <= 0)
+        return;
+
+    /**
+     * The CPU processor can be used from multiple threads, each band of rows gets its own description
+     * of the part of the image it converts
+     */
+    const std::size_t rowsize = static_cast<std::size_t>(width) * channels * sizeof(float);
+    const std::size_t rows = std::clamp<std::size_t>(s_TileSize / rowsize, 1, height);
+    const std::size_t tiles = (height + rows - 1) / rows;
+
+    TaskScheduler::Instance().ParallelFor(tiles, [&](std::size_t tile) -> void
+    {
+        const std::size_t start = tile * rows;
+        const std::size_t count = std::min<std::size_t>(height, start + rows) - start;
+
+        OCIO::PackedImageDesc imgdesc(pixels + start * width * channels, width, static_cast<long>(count), channels);
+        processor->apply(imgdesc);
+    });
+}
+
+void ColorProcessor::SwapConfig(const OCIO::ConstConfigRcPtr& config)
+{
+    /* The config is read (processors created from it) from the threads converting images */
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    m_Config = config;
+    OCIO::SetCurrentConfig(m_Config);
 
-    OCIO::PackedImageDesc imgdesc(pixels, width, height, channels);
-    cpuproc->apply(imgdesc);
+    /* Processors belonged to the previous config */
+    m_CProcessors.clear();
 }
 
 VOID_NAMESPACE_CLOSE
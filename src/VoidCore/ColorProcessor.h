@@ -5,6 +5,10 @@
 #define _VOID_COLOR_PROCESSOR_H
 
 /* STD */
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
 #include <vector>
 
 /* OpenColorIO */
@@ -27,6 +31,17 @@ public: /* Enum */
         Environment
     };
 
+    /**
+     * What the CPU conversion is used for, this decides the optimization level of the OCIO processor
+     * Interactive conversions allow approximations (OCIO Draft) for speed, Export keeps to the default level
+     * which OCIO deems good for final output
+     */
+    enum class Optimization
+    {
+        Interactive,
+        Export
+    };
+
 public:
 
     /* Singleton Instance of the Processor for the Rendering System */
@@ -70,13 +85,52 @@ public:
      */
     std::string Shader(const std::string& function) const;
 
-    // CPU processing for the image from the source to destination colorspace
-    void ProcessImage(float* pixels, int width, int height, int channels, const std::string& outcolorspace) const;
-    void ProcessImage(float* pixels, int width, int height, int channels, const ColorSpace& colorspace, const std::string& outcolorspace) const;
-
-private:
+    /**
+     * CPU processing for the image from the source to destination colorspace
+     * The processors are cached for the config, and the image is converted in tiles across the task scheduler
+     */
+    void ProcessImage(
+        float* pixels,
+        int width,
+        int height,
+        int channels,
+        const std::string& outcolorspace,
+        const Optimization& optimization = Optimization::Export
+    ) const;
+    void ProcessImage(
+        float* pixels,
+        int width,
+        int height,
+        int channels,
+        const ColorSpace& colorspace,
+        const std::string& outcolorspace,
+        const Optimization& optimization = Optimization::Export
+    ) const;
+
+private: /* Members */
     OCIO_NAMESPACE::ConstConfigRcPtr m_Config;
     OCIO_NAMESPACE::ConstGPUProcessorRcPtr m_GProcessor;
+
+    /* CPU Processors for the current config, keyed by (source, destination, optimization) */
+    typedef std::tuple<std::string, std::string, Optimization> ProcessorKey;
+    mutable std::map<ProcessorKey, OCIO_NAMESPACE::ConstCPUProcessorRcPtr> m_CProcessors;
+    mutable std::mutex m_Mutex;
+
+private: /* Methods */
+    /**
+     * Returns the (cached) CPU processor for the conversion
+     */
+    OCIO_NAMESPACE::ConstCPUProcessorRcPtr CPUProcessor(const std::string& source, const std::string& destination, const Optimization& optimization) const;
+
+    /**
+     * Applies the processor on the image, splitting it into bands of rows across the task scheduler
+     */
+    void Apply(const OCIO_NAMESPACE::ConstCPUProcessorRcPtr& processor, float* pixels, int width, int height, int channels) const;
+
+    /**
+     * Replaces the config and invalidates the CPU processors created from the previous one
+     */
+    void SwapConfig(const OCIO_NAMESPACE::ConstConfigRcPtr& config);
 };
 
 VOID_NAMESPACE_CLOSE
@@ -2,6 +2,7 @@
 // Licensed under the MIT License
 
 /* STD */
+#include <algorithm>
 #include <cstring>
 
 /* Internal */
@@ -24,7 +25,6 @@ Frame::Frame(const MEntry& e)
 Frame::Frame(const MEntry& e, v_frame_t frame)
     : m_MediaEntry(e)
     , m_Framenumber(frame)
-    , m_Writable(nullptr)
 {
     // Since we have the Media Entry, we can now get the PixReader for the media type
     m_ImageData = std::move(Forge::Instance().GetImageReader(
@@ -90,7 +90,24 @@ SharedPixels Frame::Image(bool cached)
     if (cached)
         Cache();
 
-    return m_Writable && !m_Writable->Empty() ? m_Writable : m_ImageData;
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    /* The evaluated image for the active effects if there is one */
+    if (m_EvaluatedKey && m_Evaluated.image && m_Evaluated.key == m_EvaluatedKey)
+        return m_Evaluated.image;
+
+    return m_ImageData;
+}
+
+SharedPixels Frame::Evaluated(std::size_t key, const std::vector<ParamSnapshot>& params)
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+    m_EvaluatedKey = key;
+
+    if (m_Evaluated.image && m_Evaluated.key == key && m_Evaluated.params == params)
+        return m_Evaluated.image;
+
+    return nullptr;
 }
 
 SharedPixels Frame::Writable()
@@ -98,18 +115,55 @@ SharedPixels Frame::Writable()
     // Ensure we have the image already read, else we can't have a valid writable copy
     Cache();
 
-    // Coming from the fact that everytime the Image buffer is copied into the m_Writable shared pointer
-    // We're continuously allocating and deallocating huge amounts of data
-    // instead here we allocate only once, the first time when the writable buffer does not exist
-    // next time onwards, just copy the underlying original image data onto the writable buffer
-    // save us from the extra memory alloc-dealloc
-    if (m_Writable && m_Writable->FrameSize() == m_ImageData->FrameSize())
-        std::memcpy(m_Writable->Writable(), m_ImageData->Pixels(), m_ImageData->FrameSize());
+    std::lock_guard<std::mutex> guard(m_Mutex);
+    SharedPixels image;
+
+    /**
+     * Instead of allocating for every evaluation, the earlier evaluated image gives up its allocation
+     * and the original image data is just copied onto it, unless something (e.g. the viewer) still holds on to it
+     * it is taken off the frame either way, as it is about to be replaced
+     */
+    if (m_Evaluated.image && m_Evaluated.image.use_count() == 1 && m_Evaluated.image->FrameSize() == m_ImageData->FrameSize())
+    {
+        image = std::move(m_Evaluated.image);
+        std::memcpy(image->Writable(), m_ImageData->Pixels(), m_ImageData->FrameSize());
+    }
     else
-        m_Writable = m_ImageData->Copy();
+        image = m_ImageData->Copy();
 
-    // m_Writable = m_ImageData->Copy();
-    return m_Writable;
+    m_Evaluated = Evaluation();
+    return image;
+}
+
+void Frame::SetEvaluated(std::size_t key, const std::vector<ParamSnapshot>& params, const SharedPixels& image)
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    m_Evaluated.key = key;
+    m_Evaluated.params = params;
+    m_Evaluated.image = image;
+    m_EvaluatedKey = key;
+}
+
+SharedPixels Frame::Copy()
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    if (!m_ImageData->Empty())
+        return m_ImageData->Copy();
+
+    /* Read only for the copy, whoever caches the frame reads it again */
+    m_ImageData->Read();
+    SharedPixels image = m_ImageData->Copy();
+    m_ImageData->Clear();
+
+    return image;
+}
+
+void Frame::ReleaseEvaluated()
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+    m_Evaluated = Evaluation();
 }
 
 void Frame::Cache()
@@ -141,11 +195,10 @@ void Frame::ClearCache(bool dirty)
         std::lock_guard<std::mutex> guard(m_Mutex);
         m_ImageData->Clear();
     }
-    if (m_Writable && !m_Writable->Empty())
     {
-        // Don't allow concurrent access when clearing the underlying data vector
+        // Don't allow concurrent access when releasing the evaluated image, a cache thread could be setting it
         std::lock_guard<std::mutex> guard(m_Mutex);
-        m_Writable->Clear();
+        m_Evaluated = Evaluation();
     }
     m_Dirty = dirty;
 }
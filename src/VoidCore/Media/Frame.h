@@ -6,9 +6,11 @@
 
 /* STD */
 #include <mutex>
+#include <vector>
 
 /* Internal */
 #include "Definition.h"
+#include "Param.h"
 #include "PixReader.h"
 #include "Filesystem.h"
 
@@ -47,6 +49,8 @@ public:
     [[nodiscard]] inline bool Valid() const { return bool(m_ImageData); }
     [[nodiscard]] inline bool Invalid() const { return !m_ImageData; }
     [[nodiscard]] inline bool Dirty() const { return m_Dirty; }
+    /* Whether the pixel data for the frame has been read and is available in memory */
+    [[nodiscard]] inline bool Cached() const { return m_ImageData && !m_ImageData->Empty(); }
     [[nodiscard]] inline int Channels() const { return m_Channels; }
 
     /**
@@ -55,8 +59,40 @@ public:
      * has no effect if the frame has already been read
      */
     SharedPixels Image(bool cached = true);
+
+    /**
+     * Returns the evaluated (post effect) image for the key, nullptr if the frame hasn't been evaluated for it
+     * the key becomes the active one, and its image is what gets returned from Image()
+     * A key of 0 refers to no effects, i.e. the original image
+     * The key is only a hash of the params, an evaluation is returned only if its params match as well
+     */
+    SharedPixels Evaluated(std::size_t key, const std::vector<ParamSnapshot>& params = {});
+
+    /**
+     * Returns a copy of the original image to be evaluated onto, nothing is stored on the frame till the evaluation
+     * is set, so a half evaluated image is never returned to any other thread
+     * The allocation of the evaluated image is reused when nothing else holds on to it
+     */
     SharedPixels Writable();
 
+    /**
+     * Keeps the evaluated image against the key and the params it was evaluated with, replacing the earlier evaluation
+     * the key becomes the active one
+     */
+    void SetEvaluated(std::size_t key, const std::vector<ParamSnapshot>& params, const SharedPixels& image);
+
+    /**
+     * Returns a copy of the original image, the frame is read for the copy if it hasn't been
+     * and is not kept cached afterwards, nothing else on the frame changes
+     */
+    SharedPixels Copy();
+
+    /**
+     * Releases the evaluated image, keeping the active key
+     * the frame gets evaluated again when it is needed next
+     */
+    void ReleaseEvaluated();
+
     /**
      * Returns the underlying metadata from the image
      */
@@ -66,10 +102,28 @@ public:
     void Cache();
     void ClearCache(bool dirty = true);
 
+protected: /* Structs */
+    struct Evaluation
+    {
+        std::size_t key = {0};
+        /* Values the image was evaluated with, telling apart the params which end up with the same key */
+        std::vector<ParamSnapshot> params;
+        SharedPixels image;
+    };
+
 protected: /* Members */
     MEntry m_MediaEntry;
     SharedPixels m_ImageData;
-    SharedPixels m_Writable;
+
+    /**
+     * Evaluated image keyed on the hash of the effects evaluated on the frame, only one is kept as it is what
+     * the frame is accounted for alongside the original, the original itself stands for no effects so switching
+     * the effects off and back on does not require the frame to be evaluated again
+     * along with the key which is currently active
+     */
+    Evaluation m_Evaluated;
+    std::size_t m_EvaluatedKey = {0};
+
     v_frame_t m_Framenumber;
     int m_Channels = {0};
     bool m_Dirty = {false};
@@ -112,6 +112,11 @@ public:
     inline SharedPixels Image(v_frame_t frame, bool cached = true) { return m_Mediaframes.at(frame - m_FirstFrame).Image(cached); }
     std::size_t FrameSize();
 
+    /**
+     * Returns whether the given frame has its pixel data read in memory
+     */
+    [[nodiscard]] inline bool Cached(v_frame_t frame) const { return m_Mediaframes.at(frame - m_FirstFrame).Cached(); }
+
     inline SharedPixels FirstImage() { return Image(m_FirstFrame); }
     inline SharedPixels LastImage() { return Image(m_LastFrame); }
 
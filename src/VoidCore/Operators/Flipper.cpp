@@ -1,24 +1,42 @@
 // Copyright (c) 2025 waaake
 // Licensed under the MIT License
 
+/* STD */
+#include <algorithm>
+#include <cstddef>
+
 /* Internal */
 #include "Flipper.h"
 
 VOID_NAMESPACE_OPEN
 
-bool FlipOp::Evaluate(ImageRow& row)
+bool FlipOp::Evaluate(ImageRow& row, const ParamSnapshot&)
 {
-    unsigned char* buffer = static_cast<unsigned char*>(row.buffer);
-    for (std::size_t i = 0; i < row.width / 2; ++i)
-    {
-        unsigned char* left = buffer + i * row.channels;
-        unsigned char* right = buffer + (row.width - 1 - i) * row.channels;
+    /* Pixels are swapped as a whole, the size of a pixel in bytes accounts for the size of each channel */
+    const std::size_t size = row.channels * row.stride;
 
-        for (std::size_t c = 0; c < row.channels; ++c)
-            std::swap(left[c], right[c]);
-    }
+    for (std::size_t i = 0; i < row.width / 2; ++i)
+        std::swap_ranges(row.Pixel<std::byte>(i), row.Pixel<std::byte>(i) + size, row.Pixel<std::byte>(row.width - 1 - i));
 
     return true;
 }
 
+TextureTransform FlipOp::Geometry(const ParamSnapshot&) const
+{
+    /* u' = 1 - u */
+    return TextureTransform(-1.f, 0.f, 1.f, 0.f, 1.f, 0.f);
+}
+
+bool FlopOp::Evaluate(ImageRow&, const ParamSnapshot&)
+{
+    /* The rows are swapped with each other, which can't happen from within a row, the Geometry is applied instead */
+    return false;
+}
+
+TextureTransform FlopOp::Geometry(const ParamSnapshot&) const
+{
+    /* v' = 1 - v */
+    return TextureTransform(1.f, 0.f, 0.f, 0.f, -1.f, 1.f);
+}
+
 VOID_NAMESPACE_CLOSE
@@ -10,10 +10,26 @@
 
 VOID_NAMESPACE_OPEN
 
+/**
+ * Mirrors the image horizontally
+ */
 class VOID_API FlipOp : public ImageOp
 {
 public:
-    bool Evaluate(ImageRow& row) override;
+    bool Evaluate(ImageRow& row, const ParamSnapshot& params) override;
+    TextureTransform Geometry(const ParamSnapshot& params) const override;
+    ShaderStage Stage() const override { return ShaderStage::Coordinate; }
+};
+
+/**
+ * Mirrors the image vertically
+ */
+class VOID_API FlopOp : public ImageOp
+{
+public:
+    bool Evaluate(ImageRow& row, const ParamSnapshot& params) override;
+    TextureTransform Geometry(const ParamSnapshot& params) const override;
+    ShaderStage Stage() const override { return ShaderStage::Coordinate; }
 };
 
 VOID_NAMESPACE_CLOSE
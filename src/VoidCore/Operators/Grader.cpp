@@ -1,135 +1,164 @@
 // Copyright (c) 2025 waaake
 // Licensed under the MIT License
 
-/* STD */
-#include <algorithm>
-#include <cmath>
-
 /* Internal */
 #include "Grader.h"
-#include "VoidCore/Logging.h"
+#include "Kernels.h"
+#include "VoidCore/VoidTools.h"
 
 VOID_NAMESPACE_OPEN
 
 GradeOp::GradeOp()
 {
-    m_RedGain = AddParam("r_gain", "Red", 1.f, Param::TypeDesc::Float);
-    m_GreenGain = AddParam("g_gain", "Green", 1.f, Param::TypeDesc::Float);
-    m_BlueGain = AddParam("b_gain", "Blue", 1.f, Param::TypeDesc::Float);
+    AddParam("r_gain", "Red", 1.f, Param::TypeDesc::Float);
+    AddParam("g_gain", "Green", 1.f, Param::TypeDesc::Float);
+    AddParam("b_gain", "Blue", 1.f, Param::TypeDesc::Float);
 }
 
-bool GradeOp::Evaluate(ImageRow& row)
+bool GradeOp::Evaluate(ImageRow& row, const ParamSnapshot& params)
 {
     if (row.channels < 3)
         return false;
 
-    // Test
-    const float r = m_RedGain->GetFloat();
-    const float g = m_GreenGain->GetFloat();
-    const float b = m_BlueGain->GetFloat();
-
-    // const float r = 1.0;
-    // const float g = 1.0;
-    // const float b = 1.0;
-
-    // auto r_param = GetParam("r_gain");
-    // if (m_RedGain)
-    // {
-    //     VOID_LOG_INFO("R Gain Param: {0}", m_RedGain->value.GetFloat());
-    //     // auto v = r_param->value.Get<float>();
-    //     // if (v)
-    //     //     VOID_LOG_INFO("R Gain Param: {0}", *v);
-    // }
-
-    for (std::size_t i = 0; i < row.width; ++i)
-    {
-        float* pixel = row.Pixel<float>(i);
-        
-        pixel[0] = std::clamp((pixel[0] * r), 0.f, 1.f);
-        pixel[1] = std::clamp((pixel[1] * g), 0.f, 1.f);
-        pixel[2] = std::clamp((pixel[2] * b), 0.f, 1.f);
-    }
+    Kernels::ChannelTransform transform;
+    transform.scale[0] = params.Float(RedGain);
+    transform.scale[1] = params.Float(GreenGain);
+    transform.scale[2] = params.Float(BlueGain);
+    transform.enabled[0] = transform.enabled[1] = transform.enabled[2] = true;
+
+    transform.clamp = true;
+    transform.lower = 0.f;
+    transform.upper = 1.f;
 
+    Kernels::Transform(transform, row);
     return true;
 }
 
+std::string GradeOp::Shader(const std::string& name) const
+{
+    std::string shader = R"(
+vec4 $NAME(vec4 color)
+{
+    color.rgb = clamp(color.rgb * vec3($NAME_r_gain, $NAME_g_gain, $NAME_b_gain), 0.0, 1.0);
+    return color;
+}
+)";
+
+    Tools::replace_all(shader, "$NAME", name);
+    return shader;
+}
+
 Grade2::Grade2()
 {
-    m_ChannelRed = AddParam("channel_red", "Red", true, Param::TypeDesc::Boolean);
-    m_ChannelGreen = AddParam("channel_green", "Green", true, Param::TypeDesc::Boolean);
-    m_ChannelBlue = AddParam("channel_blue", "Blue", true, Param::TypeDesc::Boolean);
+    AddParam("channel_red", "Red", true, Param::TypeDesc::Boolean);
+    AddParam("channel_green", "Green", true, Param::TypeDesc::Boolean);
+    AddParam("channel_blue", "Blue", true, Param::TypeDesc::Boolean);
 
-    m_Blackpoint = AddParam(
+    AddParam(
         "blackpoint", "Blackpoint", "Defines input values that maps to pure black.",
         0.f, ParamRange(-1.f, 1.f, 0.01f), Param::TypeDesc::Float
     );
-    m_Whitepoint = AddParam(
+    AddParam(
         "whitepoint", "Whitepoint", "Defines input values that maps to pure white.",
         1.f, ParamRange(1.f, 4.f, 0.01f), Param::TypeDesc::Float
     );
-    m_Lift = AddParam(
+    AddParam(
         "lift", "Lift", "Adjusts the brightness of shadows.",
         0.f, ParamRange(-1.f, 1.f, 0.1f), Param::TypeDesc::Float
     );
-    m_Gain = AddParam(
+    AddParam(
         "gain", "Gain", "Scales the intensity of highlights.",
         1.f, ParamRange(0.f, 4.f, 0.1f), Param::TypeDesc::Float
     );
-    m_Multiply = AddParam(
+    AddParam(
         "multiply", "Multiply", "Scales the image brightness.",
         1.f, ParamRange(0.f, 4.f, 0.1f), Param::TypeDesc::Float
     );
-    m_Offset = AddParam(
+    AddParam(
         "offset", "Offset", "Shifts brighness up or down across pixels.",
         0.f, ParamRange(-1.f, 1.f, 0.01f), Param::TypeDesc::Float
     );
-    m_Gamma = AddParam(
+    AddParam(
         "gamma", "Gamma", "Controls midtones contrast with non-linear adjustment.",
         1.f, ParamRange(0.2f, 5.f, 0.1f), Param::TypeDesc::Float
     );
 }
 
-bool Grade2::Evaluate(ImageRow& row)
+bool Grade2::Evaluate(ImageRow& row, const ParamSnapshot& params)
 {
     if (row.channels < 3)
         return false;
 
-    const float blackpoint = m_Blackpoint->GetFloat();
-    const float whitepoint = m_Whitepoint->GetFloat();
-    const float lift = m_Lift->GetFloat();
-    const float gain = m_Gain->GetFloat();
-    const float multiply = m_Multiply->GetFloat();
-    const float offset = m_Offset->GetFloat();
-    const float gamma = m_Gamma->GetFloat();
+    const float blackpoint = params.Float(Blackpoint);
+    const float whitepoint = params.Float(Whitepoint);
+    const float lift = params.Float(Lift);
+    const float gain = params.Float(Gain);
+    const float multiply = params.Float(Multiply);
+    const float offset = params.Float(Offset);
+    const float gamma = params.Float(Gamma);
 
-    const bool redchan = m_ChannelRed->GetBool();
-    const bool greenchan = m_ChannelGreen->GetBool();
-    const bool bluechan = m_ChannelBlue->GetBool();
+    const bool redchan = params.Bool(ChannelRed);
+    const bool greenchan = params.Bool(ChannelGreen);
+    const bool bluechan = params.Bool(ChannelBlue);
+    const bool alphachan = row.channels > 3;
+
+    // Nothing to be graded on the row
+    if (!redchan && !greenchan && !bluechan && !alphachan)
+        return true;
 
     // Based on formula from https://www.chrisbturner.com/blog/nukes-grade-node-demystified
     // pow((((x - blackpoint) / (whitepoint - blackpoint) * ((gain * multiply) - lift)) + lift) + offset, (1 / gamma))
-    for (std::size_t i = 0; i < row.width; ++i)
-    {
-        float* pixel = row.Pixel<float>(i);
+    // which folds into pow(x * A + B, 1 / gamma) with
+    // A = ((gain * multiply) - lift) / (whitepoint - blackpoint) and B = lift + offset - blackpoint * A
+    const float scale = ((gain * multiply) - lift) / (whitepoint - blackpoint);
+    const float bias = lift + offset - blackpoint * scale;
 
-        // Red
-        if (redchan)
-            pixel[0] = pow((((pixel[0] - blackpoint) / (whitepoint - blackpoint) * ((gain * multiply) - lift)) + lift) + offset, (1 / gamma));
+    // The values for which the grade leaves the pixels as is
+    if (scale == 1.f && bias == 0.f && gamma == 1.f)
+        return true;
 
-        // Green
-        if (greenchan)
-            pixel[1] = pow((((pixel[1] - blackpoint) / (whitepoint - blackpoint) * ((gain * multiply) - lift)) + lift) + offset, (1 / gamma));
+    Kernels::ChannelTransform transform;
+    for (std::size_t c = 0; c < 4; ++c)
+    {
+        transform.scale[c] = scale;
+        transform.bias[c] = bias;
+        transform.exponent[c] = 1.f / gamma;
+    }
 
-        // Blue
-        if (bluechan)
-            pixel[2] = pow((((pixel[2] - blackpoint) / (whitepoint - blackpoint) * ((gain * multiply) - lift)) + lift) + offset, (1 / gamma));
+    transform.enabled[0] = redchan;
+    transform.enabled[1] = greenchan;
+    transform.enabled[2] = bluechan;
+    transform.enabled[3] = alphachan;
 
-        // Alpha
-        if (row.channels > 3)
-            pixel[3] = pow((((pixel[3] - blackpoint) / (whitepoint - blackpoint) * ((gain * multiply) - lift)) + lift) + offset, (1 / gamma));
-    }
+    /* Non positive values end up as 0 rather than NaN when raised */
+    transform.power = gamma != 1.f;
+
+    Kernels::Transform(transform, row);
 
     return true;
 }
 
+std::string Grade2::Shader(const std::string& name) const
+{
+    // Same as the CPU path, the grade is folded into pow(x * A + B, 1 / gamma)
+    // and the alpha is only graded if the image has it
+    std::string shader = R"(
+vec4 $NAME(vec4 color)
+{
+    float scale = (($NAME_gain * $NAME_multiply) - $NAME_lift) / ($NAME_whitepoint - $NAME_blackpoint);
+    float bias = $NAME_lift + $NAME_offset - $NAME_blackpoint * scale;
+
+    vec4 graded = color * scale + bias;
+
+    if ($NAME_gamma != 1.0)
+        graded = mix(vec4(0.0), pow(max(graded, 0.0), vec4(1.0 / $NAME_gamma)), greaterThan(graded, vec4(0.0)));
+
+    return mix(color, graded, bvec4($NAME_channel_red, $NAME_channel_green, $NAME_channel_blue, channels > 3));
+}
+)";
+
+    Tools::replace_all(shader, "$NAME", name);
+    return shader;
+}
+
 VOID_NAMESPACE_CLOSE
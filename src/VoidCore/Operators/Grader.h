@@ -4,6 +4,9 @@
 #ifndef _GRADE_OPERATOR_H
 #define _GRADE_OPERATOR_H
 
+/* STD */
+#include <string>
+
 /* Internal */
 #include "Definition.h"
 #include "Operator.h"
@@ -14,32 +17,39 @@ class VOID_API GradeOp : public ImageOp
 {
 public:
     GradeOp();
-    bool Evaluate(ImageRow& row) override;
+    bool Evaluate(ImageRow& row, const ParamSnapshot& params) override;
+    std::string Shader(const std::string& name) const override;
+    inline bool Drawable() const override { return true; }
 
 private:
-    Param* m_RedGain;
-    Param* m_GreenGain;
-    Param* m_BlueGain;
+    /* Index of the params in the snapshot, in the order they are added */
+    enum Params : std::size_t { RedGain, GreenGain, BlueGain };
 };
 
 class VOID_API Grade2 : public ImageOp
 {
 public:
     Grade2();
-    bool Evaluate(ImageRow& row) override;
+    bool Evaluate(ImageRow& row, const ParamSnapshot& params) override;
+    std::string Shader(const std::string& name) const override;
+    inline bool Drawable() const override { return true; }
 
 private:
-    Param* m_ChannelRed;
-    Param* m_ChannelGreen;
-    Param* m_ChannelBlue;
-
-    Param* m_Blackpoint;
-    Param* m_Whitepoint;
-    Param* m_Lift;
-    Param* m_Gain;
-    Param* m_Multiply;
-    Param* m_Offset;
-    Param* m_Gamma;
+    /* Index of the params in the snapshot, in the order they are added */
+    enum Params : std::size_t
+    {
+        ChannelRed,
+        ChannelGreen,
+        ChannelBlue,
+
+        Blackpoint,
+        Whitepoint,
+        Lift,
+        Gain,
+        Multiply,
+        Offset,
+        Gamma
+    };
 };
 
 VOID_NAMESPACE_CLOSE
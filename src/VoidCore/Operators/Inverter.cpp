@@ -3,28 +3,44 @@
 
 /* Internal */
 #include "Inverter.h"
-#include "VoidCore/Logging.h"
+#include "Kernels.h"
+#include "VoidCore/VoidTools.h"
 
 VOID_NAMESPACE_OPEN
 
-bool InvertOp::Evaluate(ImageRow& row)
+bool InvertOp::Evaluate(ImageRow& row, const ParamSnapshot&)
 {
     if (row.channels < 3)
         return false;
 
-    for (std::size_t i = 0; i < row.width; ++i)
+    // Skip the alpha channel inversion, it causes issues at the moment with exr based data
+    // If we go back to using exrs as float data, then it might work fine, need to check that
+    // exr with float are very heavy as well (4 byte per channel vs 1 byte -- 8 bits for unsigned char), 
+    // need to check that as well for later
+    Kernels::ChannelTransform transform;
+    for (std::size_t channel = 0; channel < 3; ++channel)
     {
-        float* pixel = row.Pixel<float>(i);
-
-        // Skip the alpha channel inversion, it causes issues at the moment with exr based data
-        // If we go back to using exrs as float data, then it might work fine, need to check that
-        // exr with float are very heavy as well (4 byte per channel vs 1 byte -- 8 bits for unsigned char), 
-        // need to check that as well for later
-        for (std::size_t channel = 0; channel < 3; ++channel)
-            pixel[channel] = 1.f - pixel[channel];
+        transform.scale[channel] = -1.f;
+        transform.bias[channel] = 1.f;
+        transform.enabled[channel] = true;
     }
 
+    Kernels::Transform(transform, row);
+
     return true;
 }
 
+std::string InvertOp::Shader(const std::string& name) const
+{
+    std::string shader = R"(
+vec4 $NAME(vec4 color)
+{
+    return vec4(1.0 - color.rgb, color.a);
+}
+)";
+
+    Tools::replace_all(shader, "$NAME", name);
+    return shader;
+}
+
 VOID_NAMESPACE_CLOSE
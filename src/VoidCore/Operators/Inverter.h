@@ -4,6 +4,9 @@
 #ifndef _INVERT_OPERATOR_H
 #define _INVERT_OPERATOR_H
 
+/* STD */
+#include <string>
+
 /* Internal */
 #include "Definition.h"
 #include "Operator.h"
@@ -13,7 +16,9 @@ VOID_NAMESPACE_OPEN
 class VOID_API InvertOp : public ImageOp
 {
 public:
-    bool Evaluate(ImageRow& row) override;
+    bool Evaluate(ImageRow& row, const ParamSnapshot& params) override;
+    std::string Shader(const std::string& name) const override;
+    inline bool Drawable() const override { return true; }
 };
 
 VOID_NAMESPACE_CLOSE
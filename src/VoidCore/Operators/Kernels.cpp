@@ -0,0 +1,205 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#ifdef _WIN32
+/* https://github.com/AcademySoftwareFoundation/Imath/issues/212 */
+#define IMATH_HALF_NO_LOOKUP_TABLE
+#endif
+
+/* STD */
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+/* Imath */
+#include <Imath/half.h>
+
+/* Internal */
+#include "Kernels.h"
+#include "KernelsImpl.h"
+
+VOID_NAMESPACE_OPEN
+
+namespace Kernels {
+
+typedef void (*TransformFn)(const ChannelTransform&, float*, std::size_t, std::size_t);
+
+static void TransformScalar(const ChannelTransform& t, float* data, std::size_t pixels, std::size_t channels)
+{
+    TransformPixels<ScalarTraits, ScalarTraits>(t, data, pixels, channels);
+}
+
+struct Dispatch
+{
+    TransformFn transform;
+    const char* name;
+};
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+/**
+ * Support for the instruction sets, this includes the OS having enabled saving the extended registers
+ */
+static bool SupportsAVX512()
+{
+    #if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+
+    /* OSXSAVE */
+    if (!(info[2] & (1 << 27)))
+        return false;
+
+    /* XMM, YMM and the opmask, ZMM_Hi256, Hi16_ZMM states */
+    if ((_xgetbv(0) & 0xE6) != 0xE6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return info[1] & (1 << 16);
+    #else
+    return __builtin_cpu_supports("avx512f");
+    #endif
+}
+
+static bool SupportsAVX2()
+{
+    #if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+
+    /* OSXSAVE and FMA */
+    if (!(info[2] & (1 << 27)) || !(info[2] & (1 << 12)))
+        return false;
+
+    /* XMM and YMM states */
+    if ((_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return info[1] & (1 << 5);
+    #else
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    #endif
+}
+
+static bool SupportsSSE41()
+{
+    #if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return info[2] & (1 << 19);
+    #else
+    return __builtin_cpu_supports("sse4.1");
+    #endif
+}
+
+#endif // x86_64
+
+/**
+ * Picks the widest available implementation, this is only done once
+ */
+static const Dispatch& Selected()
+{
+    static const Dispatch dispatch = []() -> Dispatch {
+        #if defined(__x86_64__) || defined(_M_X64)
+        if (SupportsAVX512())
+            return {TransformAVX512, "AVX-512"};
+        if (SupportsAVX2())
+            return {TransformAVX2, "AVX2"};
+        if (SupportsSSE41())
+            return {TransformSSE41, "SSE4.1"};
+        #endif
+
+        return {TransformScalar, "Scalar"};
+    }();
+
+    return dispatch;
+}
+
+void Transform(const ChannelTransform& transform, float* data, std::size_t pixels, std::size_t channels)
+{
+    if (!channels || !pixels)
+        return;
+
+    if (channels <= 4)
+        return Selected().transform(transform, data, pixels, channels);
+
+    /* Lanes don't map onto channels beyond the 4th, transform the first 4 of each pixel */
+    for (std::size_t i = 0; i < pixels; ++i)
+        Selected().transform(transform, data + i * channels, 1, 4);
+}
+
+/**
+ * Conversion of the channel types to and from (normalized) float
+ */
+template <typename T>
+struct Channel;
+
+template <>
+struct Channel<std::uint8_t>
+{
+    static inline float ToFloat(std::uint8_t v) { return v * (1.f / 255.f); }
+    static inline std::uint8_t FromFloat(float v) { return static_cast<std::uint8_t>(std::clamp(v, 0.f, 1.f) * 255.f + 0.5f); }
+};
+
+template <>
+struct Channel<std::uint16_t>
+{
+    static inline float ToFloat(std::uint16_t v) { return v * (1.f / 65535.f); }
+    static inline std::uint16_t FromFloat(float v) { return static_cast<std::uint16_t>(std::clamp(v, 0.f, 1.f) * 65535.f + 0.5f); }
+};
+
+template <>
+struct Channel<Imath::half>
+{
+    static inline float ToFloat(Imath::half v) { return static_cast<float>(v); }
+    static inline Imath::half FromFloat(float v) { return Imath::half(v); }
+};
+
+template <typename T>
+static void TransformRow(const ChannelTransform& transform, T* data, std::size_t pixels, std::size_t channels)
+{
+    /* A row worth of floats per thread, reused across rows */
+    thread_local std::vector<float> scratch;
+
+    const std::size_t count = pixels * channels;
+    scratch.resize(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+        scratch[i] = Channel<T>::ToFloat(data[i]);
+
+    Transform(transform, scratch.data(), pixels, channels);
+
+    for (std::size_t i = 0; i < count; ++i)
+        data[i] = Channel<T>::FromFloat(scratch[i]);
+}
+
+void Transform(const ChannelTransform& transform, ImageRow& row)
+{
+    switch (row.type)
+    {
+        case PixelType::Uint8:
+            return TransformRow(transform, static_cast<std::uint8_t*>(row.buffer), row.width, row.channels);
+        case PixelType::Uint16:
+            return TransformRow(transform, static_cast<std::uint16_t*>(row.buffer), row.width, row.channels);
+        case PixelType::Half:
+            return TransformRow(transform, static_cast<Imath::half*>(row.buffer), row.width, row.channels);
+        case PixelType::Float:
+        default:
+            return Transform(transform, static_cast<float*>(row.buffer), row.width, row.channels);
+    }
+}
+
+const char* InstructionSet()
+{
+    return Selected().name;
+}
+
+} // namespace Kernels
+
+VOID_NAMESPACE_CLOSE
@@ -0,0 +1,75 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#ifndef _VOID_KERNELS_H
+#define _VOID_KERNELS_H
+
+/* STD */
+#include <cstddef>
+
+/* Internal */
+#include "Definition.h"
+#include "Row.h"
+
+VOID_NAMESPACE_OPEN
+
+namespace Kernels {
+
+    /**
+     * @brief Describes a per channel transformation of float pixels.
+     *
+     * For each of the (atmost 4) enabled channels of a pixel the value is transformed as
+     *      v = x * scale + bias
+     *      v = clamp(v, lower, upper)      -- if clamp
+     *      v = pow(v, exponent)            -- if power
+     * Disabled channels (and any channel beyond the 4th) are left as they are.
+     *
+     * The power is a fast approximation whose relative error grows with the exponent, about 1.6e-4 for an
+     * exponent of 1, 3e-4 for 2.4 (display gamma) and 4.3e-4 for 4, non positive values raise to 0.
+     */
+    struct ChannelTransform
+    {
+        float scale[4] = {1.f, 1.f, 1.f, 1.f};
+        float bias[4] = {0.f, 0.f, 0.f, 0.f};
+        float exponent[4] = {1.f, 1.f, 1.f, 1.f};
+        bool enabled[4] = {false, false, false, false};
+
+        bool clamp = false;
+        float lower = 0.f;
+        float upper = 1.f;
+
+        bool power = false;
+    };
+
+    /**
+     * @brief Applies the transform on interleaved float pixels.
+     * The implementation is picked at runtime based on the features of the CPU, AVX-512, AVX2 + FMA or SSE4.1
+     * on x86_64 with a scalar fallback.
+     *
+     * @param transform The transformation to be applied.
+     * @param data Pointer to the first channel of the first pixel.
+     * @param pixels Number of pixels.
+     * @param channels Number of channels in each pixel.
+     */
+    VOID_API void Transform(const ChannelTransform& transform, float* data, std::size_t pixels, std::size_t channels);
+
+    /**
+     * @brief Applies the transform on a row of pixels of any of the pixel types.
+     * Float rows are transformed in place, rows of the other types are converted to float (normalized for
+     * the integer types) a row at a time, transformed and converted back so the buffer stays in its type.
+     *
+     * @param transform The transformation to be applied.
+     * @param row Row of pixels.
+     */
+    VOID_API void Transform(const ChannelTransform& transform, ImageRow& row);
+
+    /**
+     * @brief Returns the name of the instruction set used for the kernels on this CPU.
+     */
+    VOID_API const char* InstructionSet();
+
+} // namespace Kernels
+
+VOID_NAMESPACE_CLOSE
+
+#endif // _VOID_KERNELS_H
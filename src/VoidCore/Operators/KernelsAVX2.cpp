@@ -0,0 +1,61 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+/* STD */
+#include <immintrin.h>
+
+/* Internal */
+#include "KernelsImpl.h"
+
+VOID_NAMESPACE_OPEN
+
+namespace Kernels {
+
+namespace {
+
+    struct AVX2Traits
+    {
+        typedef __m256 V;
+        typedef __m256i I;
+        typedef __m256 M;
+        static const std::size_t Lanes = 8;
+
+        static inline V Set(float v) { return _mm256_set1_ps(v); }
+        static inline I SetInt(int v) { return _mm256_set1_epi32(v); }
+        static inline V Load(const float* p) { return _mm256_loadu_ps(p); }
+        static inline void Store(float* p, V v) { _mm256_storeu_ps(p, v); }
+
+        static inline V Add(V a, V b) { return _mm256_add_ps(a, b); }
+        static inline V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+        static inline V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+        static inline V Div(V a, V b) { return _mm256_div_ps(a, b); }
+        static inline V Fma(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+        static inline V Min(V a, V b) { return _mm256_min_ps(a, b); }
+        static inline V Max(V a, V b) { return _mm256_max_ps(a, b); }
+
+        static inline M Less(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static inline V Select(M mask, V a, V b) { return _mm256_blendv_ps(b, a, mask); }
+
+        static inline I And(I a, I b) { return _mm256_and_si256(a, b); }
+        static inline I Or(I a, I b) { return _mm256_or_si256(a, b); }
+        static inline V ToFloat(I v) { return _mm256_cvtepi32_ps(v); }
+        static inline I Truncate(V v) { return _mm256_cvttps_epi32(v); }
+
+        static inline I AsInt(V v) { return _mm256_castps_si256(v); }
+        static inline V AsFloat(I v) { return _mm256_castsi256_ps(v); }
+    };
+
+} // namespace
+
+void TransformAVX2(const ChannelTransform& t, float* data, std::size_t pixels, std::size_t channels)
+{
+    TransformPixels<AVX2Traits, ScalarTraits>(t, data, pixels, channels);
+}
+
+} // namespace Kernels
+
+VOID_NAMESPACE_CLOSE
+
+#endif // x86_64
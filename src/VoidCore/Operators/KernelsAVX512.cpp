@@ -0,0 +1,62 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+/* STD */
+#include <immintrin.h>
+
+/* Internal */
+#include "KernelsImpl.h"
+
+VOID_NAMESPACE_OPEN
+
+namespace Kernels {
+
+namespace {
+
+    struct AVX512Traits
+    {
+        typedef __m512 V;
+        typedef __m512i I;
+        typedef __mmask16 M;
+        static const std::size_t Lanes = 16;
+
+        static inline V Set(float v) { return _mm512_set1_ps(v); }
+        static inline I SetInt(int v) { return _mm512_set1_epi32(v); }
+        static inline V Load(const float* p) { return _mm512_loadu_ps(p); }
+        static inline void Store(float* p, V v) { _mm512_storeu_ps(p, v); }
+
+        static inline V Add(V a, V b) { return _mm512_add_ps(a, b); }
+        static inline V Sub(V a, V b) { return _mm512_sub_ps(a, b); }
+        static inline V Mul(V a, V b) { return _mm512_mul_ps(a, b); }
+        static inline V Div(V a, V b) { return _mm512_div_ps(a, b); }
+        static inline V Fma(V a, V b, V c) { return _mm512_fmadd_ps(a, b, c); }
+        static inline V Min(V a, V b) { return _mm512_min_ps(a, b); }
+        static inline V Max(V a, V b) { return _mm512_max_ps(a, b); }
+
+        /* Comparisons produce a mask register rather than a vector */
+        static inline M Less(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+        static inline V Select(M mask, V a, V b) { return _mm512_mask_blend_ps(mask, b, a); }
+
+        static inline I And(I a, I b) { return _mm512_and_si512(a, b); }
+        static inline I Or(I a, I b) { return _mm512_or_si512(a, b); }
+        static inline V ToFloat(I v) { return _mm512_cvtepi32_ps(v); }
+        static inline I Truncate(V v) { return _mm512_cvttps_epi32(v); }
+
+        static inline I AsInt(V v) { return _mm512_castps_si512(v); }
+        static inline V AsFloat(I v) { return _mm512_castsi512_ps(v); }
+    };
+
+} // namespace
+
+void TransformAVX512(const ChannelTransform& t, float* data, std::size_t pixels, std::size_t channels)
+{
+    TransformPixels<AVX512Traits, ScalarTraits>(t, data, pixels, channels);
+}
+
+} // namespace Kernels
+
+VOID_NAMESPACE_CLOSE
+
+#endif // x86_64
@@ -0,0 +1,223 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#ifndef _VOID_KERNELS_IMPL_H
+#define _VOID_KERNELS_IMPL_H
+
+/**
+ * Kernels written once against a set of SIMD traits, this is included by the translation units
+ * which are compiled for a specific instruction set, each of which defines its traits and instantiates
+ * the kernels with it
+ *
+ * Nothing apart from <cstddef> is included here as anything inline from the standard library would be
+ * compiled with the instruction set of the translation unit and could end up being used by code that
+ * runs on a CPU without it
+ */
+
+/* STD */
+#include <cstddef>
+
+/* Internal */
+#include "Kernels.h"
+
+VOID_NAMESPACE_OPEN
+
+namespace Kernels {
+
+namespace {
+
+    /**
+     * Fast log2 for positive values (Paul Mineiro's fastapprox)
+     * The float is split into its exponent and mantissa, the mantissa gets a rational approximation
+     */
+    template <typename S>
+    inline typename S::V Log2(typename S::V x)
+    {
+        typedef typename S::V V;
+        typedef typename S::I I;
+
+        const I bits = S::AsInt(x);
+
+        /* Exponent (and mantissa) bits as a float, scaled down by 2^-23 */
+        V y = S::Mul(S::ToFloat(bits), S::Set(1.1920928955078125e-7f));
+
+        /* Mantissa in [0.5, 1) */
+        V m = S::AsFloat(S::Or(S::And(bits, S::SetInt(0x007FFFFF)), S::SetInt(0x3F000000)));
+
+        y = S::Sub(y, S::Set(124.22551499f));
+        y = S::Sub(y, S::Mul(S::Set(1.498030302f), m));
+        return S::Sub(y, S::Div(S::Set(1.72587999f), S::Add(S::Set(0.3520887068f), m)));
+    }
+
+    /**
+     * Fast 2^p (Paul Mineiro's fastapprox)
+     * The integer part forms the exponent, the fraction gets a rational approximation
+     */
+    template <typename S>
+    inline typename S::V Pow2(typename S::V p)
+    {
+        typedef typename S::V V;
+
+        /* Keep within the range of a float */
+        V clipped = S::Min(S::Max(p, S::Set(-126.f)), S::Set(127.99f));
+
+        /* Fraction of the power, offset by 1 for negatives as the truncation rounds towards 0 */
+        V offset = S::Select(S::Less(clipped, S::Set(0.f)), S::Set(1.f), S::Set(0.f));
+        V z = S::Add(S::Sub(clipped, S::ToFloat(S::Truncate(clipped))), offset);
+
+        V v = S::Add(clipped, S::Set(121.2740575f));
+        v = S::Add(v, S::Div(S::Set(27.7280233f), S::Sub(S::Set(4.84252568f), z)));
+        v = S::Sub(v, S::Mul(S::Set(1.49012907f), z));
+
+        return S::AsFloat(S::Truncate(S::Mul(S::Set(8388608.f), v)));
+    }
+
+    /**
+     * x ^ e for x > 0, and 0 for anything else
+     * The error of the log2 is scaled by the exponent before the 2^p, so the relative error grows with it
+     */
+    template <typename S>
+    inline typename S::V Pow(typename S::V x, typename S::V e)
+    {
+        typename S::V r = Pow2<S>(S::Mul(e, Log2<S>(x)));
+        return S::Select(S::Less(S::Set(0.f), x), r, S::Set(0.f));
+    }
+
+    /**
+     * Coefficients of the transform laid out for a vector of lanes
+     */
+    template <typename S>
+    struct Coefficients
+    {
+        typename S::V scale, bias, exponent;
+        typename S::M enabled;
+    };
+
+    template <typename S>
+    inline typename S::V Apply(const ChannelTransform& t, const Coefficients<S>& c, typename S::V x)
+    {
+        typename S::V v = S::Fma(x, c.scale, c.bias);
+
+        if (t.clamp)
+            v = S::Min(S::Max(v, S::Set(t.lower)), S::Set(t.upper));
+
+        if (t.power)
+            v = Pow<S>(v, c.exponent);
+
+        return S::Select(c.enabled, v, x);
+    }
+
+    /**
+     * Applies the transform over the interleaved pixels (atmost 4 channels)
+     *
+     * As the pixels are interleaved, the channel a lane refers to repeats every channels' count of lanes
+     * a block of (Lanes x channels) values has exactly channels' count of vectors in it, each of which
+     * has its own coefficients laid out based on the channel each of its lanes refers to
+     *
+     * Whatever remains after the last complete block is processed with the scalar traits
+     */
+    template <typename S, typename Scalar>
+    void TransformPixels(const ChannelTransform& t, float* data, std::size_t pixels, std::size_t channels)
+    {
+        const std::size_t lanes = S::Lanes;
+        const std::size_t block = lanes * channels;
+        const std::size_t count = pixels * channels;
+
+        Coefficients<S> coefficients[4];
+
+        for (std::size_t k = 0; k < channels; ++k)
+        {
+            float scale[S::Lanes], bias[S::Lanes], exponent[S::Lanes], enabled[S::Lanes];
+
+            for (std::size_t l = 0; l < lanes; ++l)
+            {
+                const std::size_t c = (k * lanes + l) % channels;
+                scale[l] = t.scale[c];
+                bias[l] = t.bias[c];
+                exponent[l] = t.exponent[c];
+                enabled[l] = t.enabled[c] ? 1.f : 0.f;
+            }
+
+            coefficients[k].scale = S::Load(scale);
+            coefficients[k].bias = S::Load(bias);
+            coefficients[k].exponent = S::Load(exponent);
+            coefficients[k].enabled = S::Less(S::Set(0.f), S::Load(enabled));
+        }
+
+        std::size_t i = 0;
+
+        for (; i + block <= count; i += block)
+        {
+            for (std::size_t k = 0; k < channels; ++k)
+            {
+                float* p = data + i + k * lanes;
+                S::Store(p, Apply<S>(t, coefficients[k], S::Load(p)));
+            }
+        }
+
+        /* The remaining pixels, a block always ends at a pixel boundary */
+        for (; i < count; i += channels)
+        {
+            for (std::size_t c = 0; c < channels; ++c)
+            {
+                Coefficients<Scalar> sc;
+                sc.scale = t.scale[c];
+                sc.bias = t.bias[c];
+                sc.exponent = t.exponent[c];
+                sc.enabled = t.enabled[c];
+
+                data[i + c] = Apply<Scalar>(t, sc, data[i + c]);
+            }
+        }
+    }
+
+    /**
+     * Scalar traits, these are what the remainder of the SIMD kernels and the fallback use
+     * so that the approximations are the same regardless of where the value lies in the row
+     */
+    struct ScalarTraits
+    {
+        typedef float V;
+        typedef int I;
+        typedef bool M;
+        static const std::size_t Lanes = 1;
+
+        static inline V Set(float v) { return v; }
+        static inline I SetInt(int v) { return v; }
+        static inline V Load(const float* p) { return *p; }
+        static inline void Store(float* p, V v) { *p = v; }
+
+        static inline V Add(V a, V b) { return a + b; }
+        static inline V Sub(V a, V b) { return a - b; }
+        static inline V Mul(V a, V b) { return a * b; }
+        static inline V Div(V a, V b) { return a / b; }
+        static inline V Fma(V a, V b, V c) { return a * b + c; }
+        static inline V Min(V a, V b) { return a < b ? a : b; }
+        static inline V Max(V a, V b) { return a > b ? a : b; }
+
+        static inline M Less(V a, V b) { return a < b; }
+        static inline V Select(M mask, V a, V b) { return mask ? a : b; }
+
+        static inline I And(I a, I b) { return a & b; }
+        static inline I Or(I a, I b) { return a | b; }
+        static inline V ToFloat(I v) { return static_cast<float>(v); }
+        static inline I Truncate(V v) { return static_cast<int>(v); }
+
+        static inline I AsInt(V v) { union { float f; int i; } u; u.f = v; return u.i; }
+        static inline V AsFloat(I v) { union { int i; float f; } u; u.i = v; return u.f; }
+    };
+
+} // namespace
+
+    /**
+     * Instruction set specific kernels, defined in their own translation units (x86_64 only)
+     */
+    void TransformSSE41(const ChannelTransform& t, float* data, std::size_t pixels, std::size_t channels);
+    void TransformAVX2(const ChannelTransform& t, float* data, std::size_t pixels, std::size_t channels);
+    void TransformAVX512(const ChannelTransform& t, float* data, std::size_t pixels, std::size_t channels);
+
+} // namespace Kernels
+
+VOID_NAMESPACE_CLOSE
+
+#endif // _VOID_KERNELS_IMPL_H
@@ -0,0 +1,61 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+/* STD */
+#include <immintrin.h>
+
+/* Internal */
+#include "KernelsImpl.h"
+
+VOID_NAMESPACE_OPEN
+
+namespace Kernels {
+
+namespace {
+
+    struct SSE41Traits
+    {
+        typedef __m128 V;
+        typedef __m128i I;
+        typedef __m128 M;
+        static const std::size_t Lanes = 4;
+
+        static inline V Set(float v) { return _mm_set1_ps(v); }
+        static inline I SetInt(int v) { return _mm_set1_epi32(v); }
+        static inline V Load(const float* p) { return _mm_loadu_ps(p); }
+        static inline void Store(float* p, V v) { _mm_storeu_ps(p, v); }
+
+        static inline V Add(V a, V b) { return _mm_add_ps(a, b); }
+        static inline V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+        static inline V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+        static inline V Div(V a, V b) { return _mm_div_ps(a, b); }
+        static inline V Fma(V a, V b, V c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        static inline V Min(V a, V b) { return _mm_min_ps(a, b); }
+        static inline V Max(V a, V b) { return _mm_max_ps(a, b); }
+
+        static inline M Less(V a, V b) { return _mm_cmplt_ps(a, b); }
+        static inline V Select(M mask, V a, V b) { return _mm_blendv_ps(b, a, mask); }
+
+        static inline I And(I a, I b) { return _mm_and_si128(a, b); }
+        static inline I Or(I a, I b) { return _mm_or_si128(a, b); }
+        static inline V ToFloat(I v) { return _mm_cvtepi32_ps(v); }
+        static inline I Truncate(V v) { return _mm_cvttps_epi32(v); }
+
+        static inline I AsInt(V v) { return _mm_castps_si128(v); }
+        static inline V AsFloat(I v) { return _mm_castsi128_ps(v); }
+    };
+
+} // namespace
+
+void TransformSSE41(const ChannelTransform& t, float* data, std::size_t pixels, std::size_t channels)
+{
+    TransformPixels<SSE41Traits, ScalarTraits>(t, data, pixels, channels);
+}
+
+} // namespace Kernels
+
+VOID_NAMESPACE_CLOSE
+
+#endif // x86_64
@@ -1,9 +1,14 @@
 // Copyright (c) 2025 waaake
 // Licensed under the MIT License
 
+/* STD */
+#include <functional>
+#include <typeinfo>
+
 /* Internal */
 #include "Definition.h"
 #include "Operator.h"
+#include "VoidCore/VoidTools.h"
 
 VOID_NAMESPACE_OPEN
 
@@ -57,6 +62,32 @@ Param* ImageOp::AddParam(std::string name, std::string label, std::string descri
     return m_Params.emplace_back(new Param(name, label, description, value, range, type));
 }
 
+ParamSnapshot ImageOp::Snapshot() const
+{
+    ParamSnapshot snapshot;
+    snapshot.hash = typeid(*this).hash_code();
+
+    for (const Param* param : m_Params)
+    {
+        Tools::hash_combine(snapshot.hash, std::hash<ValueType>{}(param->Value()));
+
+        ParamSnapshot::Value value;
+        value.i = 0;
+
+        switch (param->type)
+        {
+            case Param::TypeDesc::Int: value.i = param->GetInt(); break;
+            case Param::TypeDesc::Float: value.f = param->GetFloat(); break;
+            case Param::TypeDesc::Boolean: value.b = param->GetBool(); break;
+            case Param::TypeDesc::String: snapshot.strings.push_back(param->GetString()); break;
+        }
+
+        snapshot.Push(value);
+    }
+
+    return snapshot;
+}
+
 Param* ImageOp::GetParam(const std::string& name)
 {
     for (auto& param : m_Params)
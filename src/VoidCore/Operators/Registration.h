@@ -6,6 +6,7 @@
 /* Internal */
 #include "Definition.h"
 #include "FormatForge.h"
+#include "Flipper.h"
 #include "Grader.h"
 #include "Inverter.h"
 
@@ -24,7 +25,20 @@ namespace Internal {
     
     bool RegisterFlipOp()
     {
-        return false;
+        IOpRegistry r;
+        r.name = "Flip";
+        r.iop = []() -> std::unique_ptr<ImageOp> { return std::make_unique<FlipOp>(); };
+
+        return Forge::Instance().Register(r);
+    }
+
+    bool RegisterFlopOp()
+    {
+        IOpRegistry r;
+        r.name = "Flop";
+        r.iop = []() -> std::unique_ptr<ImageOp> { return std::make_unique<FlopOp>(); };
+
+        return Forge::Instance().Register(r);
     }
     
     bool RegisterColorGradeOp()
@@ -50,6 +64,8 @@ namespace Internal {
 void RegisterOperators()
 {
     Internal::RegisterInvertOp();
+    Internal::RegisterFlipOp();
+    Internal::RegisterFlopOp();
     Internal::RegisterColorGradeOp();
     Internal::RegisterGrade2();
 }
@@ -1,13 +1,79 @@
 // Copyright (c) 2025 waaake
 // Licensed under the MIT License
 
+/* STD */
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/* Imath */
+#include <Imath/half.h>
+
 /* Internal */
 #include "ImageProcessor.h"
 #include "VoidCore/Logging.h"
 #include "VoidCore/Profiler.h"
+#include "VoidCore/TaskScheduler.h"
 
 VOID_NAMESPACE_OPEN
 
+/* Size of a tile of the image in bytes, small enough to stay in L2 while it's being processed */
+static const std::size_t s_TileSize = 256 * 1024;
+
+/**
+ * Averages blocks of factor x factor pixels for the rows [begin, end) of the result
+ */
+template <typename T>
+static void DownscaleRows(const T* source, T* destination, std::size_t width, std::size_t height, std::size_t channels,
+                          std::size_t factor, std::size_t begin, std::size_t end)
+{
+    const std::size_t outwidth = (width + factor - 1) / factor;
+    std::vector<float> sums(outwidth * channels);
+
+    for (std::size_t y = begin; y < end; ++y)
+    {
+        std::fill(sums.begin(), sums.end(), 0.f);
+
+        const std::size_t top = y * factor;
+        const std::size_t bottom = std::min(height, top + factor);
+
+        for (std::size_t sy = top; sy < bottom; ++sy)
+        {
+            const T* row = source + sy * width * channels;
+
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                float* sum = sums.data() + (x / factor) * channels;
+
+                for (std::size_t c = 0; c < channels; ++c)
+                    sum[c] += static_cast<float>(row[x * channels + c]);
+            }
+        }
+
+        T* out = destination + y * outwidth * channels;
+
+        for (std::size_t x = 0; x < outwidth; ++x)
+        {
+            const std::size_t count = (bottom - top) * (std::min(width, (x + 1) * factor) - x * factor);
+            const float scale = 1.f / count;
+
+            for (std::size_t c = 0; c < channels; ++c)
+            {
+                const float value = sums[x * channels + c] * scale;
+
+                if constexpr (std::is_integral_v<T>)
+                    out[x * channels + c] = static_cast<T>(value + 0.5f);
+                else
+                    out[x * channels + c] = T(value);
+            }
+        }
+    }
+}
+
 ImageProcessor& ImageProcessor::Instance()
 {
     static ImageProcessor instance;
@@ -23,27 +89,10 @@ bool ImageProcessor::Process(Frame* frame, const SharedImageOp& iop)
     bool status = false;
     if (frame->Dirty())
     {
-        Tools::VoidProfiler<std::chrono::duration<double>> p("ImageProcessor::Process");
-
-        /**
-         * Process this loop parallelly
-         * Since we are dealing with each Row of Pixels for the image separately,
-         * they can all be processed without having any overlap on the other
-         * 
-         * TODO: Check how can we safely allow one ImageOp::Evaluate to access other rows
-         * maybe with or without guarantee that it will be modified
-         */
         SharedPixels image = frame->Image(false);
-
-        #pragma omp parallel for
-        for (int i = 0; i < image->Height(); ++i)
-        {
-            ImageRow row = image->Row(i);
-            iop->Evaluate(row);
-        }
+        status = Process(image, std::vector<ImageOp*>{iop.get()});
 
         frame->SetDirty(false);
-        status = true;
     }
 
     return status;
@@ -51,25 +100,176 @@ bool ImageProcessor::Process(Frame* frame, const SharedImageOp& iop)
 
 bool ImageProcessor::Process(SharedPixels& image, ImageOp* iop)
 {
-    bool status;
-    Tools::VoidProfiler<std::chrono::duration<double>> p("ImageProcessor::Process");
+    return Process(image, std::vector<ImageOp*>{iop});
+}
+
+bool ImageProcessor::Process(SharedPixels& image, const std::vector<ImageOp*>& chain)
+{
+    std::vector<ParamSnapshot> params;
+    params.reserve(chain.size());
+
+    for (ImageOp* iop : chain)
+        params.push_back(iop->Snapshot());
+
+    return Process(image, chain, params);
+}
+
+bool ImageProcessor::Process(SharedPixels& image, const std::vector<ImageOp*>& chain, const std::vector<ParamSnapshot>& params)
+{
+    Tools::VoidProfiler<std::chrono::duration<double>> p("ImageProcessor::Process (Chain)");
+
+    const std::size_t height = static_cast<std::size_t>(image->Height());
+    if (!height || chain.empty())
+        return true;
+
+    /* Geometric operators are combined into a single transform, with the last of them applying first on a coordinate */
+    TextureTransform geometry;
+    std::vector<std::size_t> evaluated;
+    evaluated.reserve(chain.size());
+
+    for (std::size_t j = 0; j < chain.size(); ++j)
+    {
+        if (chain[j]->Geometric())
+            geometry = geometry * chain[j]->Geometry(params[j]);
+        else
+            evaluated.push_back(j);
+    }
 
     /**
-     * Process this loop parallelly
-     * Since we are dealing with each Row of Pixels for the image separately,
-     * they can all be processed without having any overlap on the other
-     * 
+     * The image is split into tiles (bands of rows) which fit in L2, these are run on the shared scheduler
+     * rather than a team of threads per call, which would multiply with the cache threads calling this
+     * Each row still goes through the entire chain before the next one is picked up
+     *
      * TODO: Check how can we safely allow one ImageOp::Evaluate to access other rows
      * maybe with or without guarantee that it will be modified
      */
-    #pragma omp parallel for
-    for (int i = 0; i < image->Height(); ++i)
+    const std::size_t rowsize = std::max<std::size_t>(image->FrameSize() / height, 1);
+    const std::size_t rows = std::clamp<std::size_t>(s_TileSize / rowsize, 1, height);
+    const std::size_t tiles = (height + rows - 1) / rows;
+
+    std::atomic<bool> failed = false;
+
+    TaskScheduler::Instance().ParallelFor(tiles, [&](std::size_t tile) -> void
     {
-        ImageRow row = image->Row(i);
-        status = iop->Evaluate(row);
-    }
+        const std::size_t end = std::min(height, (tile + 1) * rows);
+        bool status = true;
 
-    return status;
+        for (std::size_t i = tile * rows; i < end; ++i)
+        {
+            ImageRow row = image->Row(i);
+
+            for (std::size_t j : evaluated)
+                status &= chain[j]->Evaluate(row, params[j]);
+        }
+
+        if (!status)
+            failed = true;
+    });
+
+    if (!geometry.Identity())
+        return Transform(image, geometry) && !failed;
+
+    return !failed;
+}
+
+bool ImageProcessor::Transform(SharedPixels& image, const TextureTransform& transform)
+{
+    const std::size_t width = static_cast<std::size_t>(image->Width());
+    const std::size_t height = static_cast<std::size_t>(image->Height());
+
+    if (!width || !height)
+        return false;
+
+    if (transform.Identity())
+        return true;
+
+    /* Pixels are copied as a whole, whatever the type of the channels is */
+    const std::size_t pixel = image->FrameSize() / (width * height);
+
+    /* The pixels are read from a copy as they'd otherwise get overwritten before being read */
+    const std::byte* pixels = static_cast<const std::byte*>(image->Pixels());
+    const std::vector<std::byte> source(pixels, pixels + image->FrameSize());
+    std::byte* destination = static_cast<std::byte*>(image->Writable());
+
+    const float* m = transform.m;
+    const std::size_t rows = std::clamp<std::size_t>(s_TileSize / std::max<std::size_t>(width * pixel, 1), 1, height);
+    const std::size_t tiles = (height + rows - 1) / rows;
+
+    TaskScheduler::Instance().ParallelFor(tiles, [&](std::size_t tile) -> void
+    {
+        const std::size_t end = std::min(height, (tile + 1) * rows);
+
+        for (std::size_t y = tile * rows; y < end; ++y)
+        {
+            /* Coordinates are at the center of the pixels */
+            const float v = (y + 0.5f) / height;
+
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                const float u = (x + 0.5f) / width;
+
+                const long sx = static_cast<long>(std::floor((m[0] * u + m[1] * v + m[2]) * width));
+                const long sy = static_cast<long>(std::floor((m[3] * u + m[4] * v + m[5]) * height));
+
+                const std::size_t cx = static_cast<std::size_t>(std::clamp<long>(sx, 0, width - 1));
+                const std::size_t cy = static_cast<std::size_t>(std::clamp<long>(sy, 0, height - 1));
+
+                std::memcpy(destination + (y * width + x) * pixel, source.data() + (cy * width + cx) * pixel, pixel);
+            }
+        }
+    });
+
+    return true;
+}
+
+bool ImageProcessor::Downscale(const SharedPixels& image, int factor, std::vector<std::byte>& pixels, int& width, int& height)
+{
+    const std::size_t iwidth = static_cast<std::size_t>(image->Width());
+    const std::size_t iheight = static_cast<std::size_t>(image->Height());
+    const std::size_t channels = static_cast<std::size_t>(image->Channels());
+
+    if (!iwidth || !iheight || !channels || factor < 1)
+        return false;
+
+    const std::size_t f = static_cast<std::size_t>(factor);
+    const PixelType type = image->Row(0).type;
+    const std::size_t outwidth = (iwidth + f - 1) / f;
+    const std::size_t outheight = (iheight + f - 1) / f;
+
+    pixels.resize(outwidth * outheight * channels * ImageRow::Size(type));
+
+    const void* source = image->Pixels();
+    void* destination = pixels.data();
+
+    /* Bands of the result are reduced in parallel, each reading factor times as many rows of the image */
+    const std::size_t rows = std::clamp<std::size_t>(s_TileSize / std::max<std::size_t>(iwidth * channels * ImageRow::Size(type) * f, 1), 1, outheight);
+    const std::size_t tiles = (outheight + rows - 1) / rows;
+
+    TaskScheduler::Instance().ParallelFor(tiles, [&](std::size_t tile) -> void
+    {
+        const std::size_t begin = tile * rows;
+        const std::size_t end = std::min(outheight, begin + rows);
+
+        switch (type)
+        {
+            case PixelType::Uint8:
+                DownscaleRows(static_cast<const std::uint8_t*>(source), static_cast<std::uint8_t*>(destination), iwidth, iheight, channels, f, begin, end);
+                break;
+            case PixelType::Uint16:
+                DownscaleRows(static_cast<const std::uint16_t*>(source), static_cast<std::uint16_t*>(destination), iwidth, iheight, channels, f, begin, end);
+                break;
+            case PixelType::Half:
+                DownscaleRows(static_cast<const Imath::half*>(source), static_cast<Imath::half*>(destination), iwidth, iheight, channels, f, begin, end);
+                break;
+            case PixelType::Float:
+                DownscaleRows(static_cast<const float*>(source), static_cast<float*>(destination), iwidth, iheight, channels, f, begin, end);
+                break;
+        }
+    });
+
+    width = static_cast<int>(outwidth);
+    height = static_cast<int>(outheight);
+    return true;
 }
 
 void ImageProcessor::ProcessFrame(Frame* frame, const SharedImageOp& iop)
@@ -84,4 +284,9 @@ void ImageProcessor::ProcessImage(SharedPixels& image, ImageOp* iop)
     instance.Process(image, iop);
 }
 
+void ImageProcessor::ProcessImage(SharedPixels& image, const std::vector<ImageOp*>& chain)
+{
+    Instance().Process(image, chain);
+}
+
 VOID_NAMESPACE_CLOSE
@@ -4,6 +4,10 @@
 #ifndef _IMAGE_PROCESSOR_H
 #define _IMAGE_PROCESSOR_H
 
+/* STD */
+#include <cstddef>
+#include <vector>
+
 /* Internal */
 #include "Definition.h"
 #include "Operator.h"
@@ -21,8 +25,58 @@ public:
     bool Process(Frame* frame, const SharedImageOp& iop);
     bool Process(SharedPixels& image, ImageOp* iop);
 
+    /**
+     * @brief Processes the image with a chain of operators in a single pass.
+     * Each row gets evaluated by all of the operators in order while it is still in cache
+     * instead of the image being swept over once per operator.
+     * The params of the operators are snapshot before the image is processed.
+     *
+     * @param image Image to be processed in place.
+     * @param chain Operators to be evaluated, in order.
+     * @return bool true if all the operators evaluated successfully.
+     */
+    bool Process(SharedPixels& image, const std::vector<ImageOp*>& chain);
+
+    /**
+     * @brief Processes the image with a chain of operators in a single pass, evaluating each of the operators
+     * with the snapshot of its params at the same index.
+     * Geometric operators aren't evaluated per row, their transforms are combined and applied in a final pass
+     * after the rest of the chain, which (operating on each pixel on its own) isn't affected by the order.
+     *
+     * @param image Image to be processed in place.
+     * @param chain Operators to be evaluated, in order.
+     * @param params Snapshots of the params for each of the operators.
+     * @return bool true if all the operators evaluated successfully.
+     */
+    bool Process(SharedPixels& image, const std::vector<ImageOp*>& chain, const std::vector<ParamSnapshot>& params);
+
+    /**
+     * @brief Moves the pixels of the image around as described by the transform.
+     * Each pixel gets the value of the nearest pixel where the transform maps it to, clamped to the edges.
+     *
+     * @param image Image to be transformed in place.
+     * @param transform Transformation of the normalized coordinates.
+     * @return bool true if the image was transformed.
+     */
+    bool Transform(SharedPixels& image, const TextureTransform& transform);
+
+    /**
+     * @brief Reduces the image by an integer factor, each pixel of the result being the average of a block of
+     * factor x factor pixels of the image (the blocks on the right and bottom edges may be partial).
+     * The result has the same channels and type of pixels as the image.
+     *
+     * @param image Image to be reduced.
+     * @param factor Number of pixels along each side of a block.
+     * @param pixels Filled in with the pixels of the result.
+     * @param width Filled in with the width of the result.
+     * @param height Filled in with the height of the result.
+     * @return bool true if the image was reduced.
+     */
+    bool Downscale(const SharedPixels& image, int factor, std::vector<std::byte>& pixels, int& width, int& height);
+
     static void ProcessFrame(Frame* frame, const SharedImageOp& iop);
     static void ProcessImage(SharedPixels& image, ImageOp* iop);
+    static void ProcessImage(SharedPixels& image, const std::vector<ImageOp*>& chain);
 };
 
 VOID_NAMESPACE_CLOSE
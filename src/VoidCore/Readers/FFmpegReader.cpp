@@ -7,6 +7,7 @@
 
 /* Internal */
 #include "FFmpegReader.h"
+#include "VoidCore/Transfer.h"
 
 VOID_NAMESPACE_OPEN
 
@@ -233,13 +234,7 @@ v_frame_t FFmpegDecoder::DecodeNextFrame(bool save)
 
 void FFmpegDecoder::FillBuffer(std::vector<float>& out)
 {
-    for (std::size_t i = 0; i < (m_Width * m_Height); ++i)
-    {
-        int index = i * 3;
-        out[index] = Linear(m_Buffer[index] / 255.f);
-        out[index + 1] = Linear(m_Buffer[index + 1] / 255.f);
-        out[index + 2] = Linear(m_Buffer[index + 2] / 255.f);
-    }
+    Transfer::Decode(ColorSpace::sRGB, m_Buffer.Data(), out.data(), m_Width * m_Height, 3);
 }
 
 /* }}} */
@@ -314,7 +309,7 @@ ImageRow FFmpegPixReader::Row(std::size_t row)
 {
     return (row >= m_Height)
             ? ImageRow()
-            : ImageRow(m_Pixels.data(), row, m_Width, m_Channels, sizeof(float));
+            : ImageRow(m_Pixels.data(), row, m_Width, m_Channels, PixelType::Float);
 }
 
 void FFmpegPixReader::ProcessInformation()
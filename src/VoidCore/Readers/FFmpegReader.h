@@ -101,7 +101,6 @@ private: /* Methods */
      */
     v_frame_t DecodeNextFrame(bool save = true);
     void FillBuffer(std::vector<float>& out);
-    inline static float Linear(float pixel) { return (pixel <= 0.04045f) ? pixel / 12.92f : powf((pixel + 0.055f) / 1.055f, 2.4f); }
 };
 
 class VOID_API FFmpegPixReader : public VoidMPixReader
@@ -6,11 +6,11 @@
 
 /* OpenImageIO */
 #include <OpenImageIO/imageio.h>
-#include <OpenImageIO/imagebufalgo.h>
 
 /* Internal */
 #include "OIIOReader.h"
 #include "VoidCore/Logging.h"
+#include "VoidCore/Transfer.h"
 
 VOID_NAMESPACE_OPEN
 
@@ -74,7 +74,7 @@ ImageRow OIIOPixReader::Row(std::size_t row)
 {
     return (row >= m_Height)
             ? ImageRow()
-            : ImageRow(m_Pixels.data(), row, m_Width, m_Channels, sizeof(float));
+            : ImageRow(m_Pixels.data(), row, m_Width, m_Channels, PixelType::Float);
 }
 
 void OIIOPixReader::Read()
@@ -124,10 +124,8 @@ void OIIOPixReader::Read()
     input->read_image(subimage, miplevel, chbegin, chend, OIIO::TypeDesc::UINT8, original.data());
     input->close();
 
-    OIIO::ImageBuf src(spec, original.data());
-    OIIO::ImageBuf linear;
-    OIIO::ImageBufAlgo::colorconvert(linear, src, "sRGB", "Linear");
-    linear.get_pixels(OIIO::ROI::All(), OIIO::TypeDesc::FLOAT, m_Pixels.data());
+    /* sRGB to Linear, leaving the alpha as it is */
+    Transfer::Decode(ColorSpace::sRGB, original.data(), m_Pixels.data(), m_Width * m_Height, m_Channels, spec.alpha_channel);
 }
 
 const std::map<std::string, std::string> OIIOPixReader::Metadata() const
@@ -65,7 +65,7 @@ ImageRow OpenEXRReader::Row(std::size_t row)
 {
     return (row >= m_Height)
             ? ImageRow()
-            : ImageRow(m_Pixels.data(), row, m_Width, m_Channels, sizeof(float));
+            : ImageRow(m_Pixels.data(), row, m_Width, m_Channels, PixelType::Float);
 }
 
 const unsigned char* OpenEXRReader::ThumbnailPixels()
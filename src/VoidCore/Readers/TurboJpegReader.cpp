@@ -11,6 +11,7 @@
 /* Internal */
 #include "TurboJpegReader.h"
 #include "VoidCore/Logging.h"
+#include "VoidCore/Transfer.h"
 
 VOID_NAMESPACE_OPEN
 
@@ -72,7 +73,7 @@ ImageRow TurboJpegReader::Row(std::size_t row)
 {
     return (row >= m_Height)
             ? ImageRow()
-            : ImageRow(m_Pixels.data(), row, m_Width, m_Channels, sizeof(float));
+            : ImageRow(m_Pixels.data(), row, m_Width, m_Channels, PixelType::Float);
 }
 
 void TurboJpegReader::Read()
@@ -134,14 +135,8 @@ void TurboJpegReader::Read()
 
     tjDestroy(handle);
 
-    for (std::size_t i = 0; i < (m_Width * m_Height); ++i)
-    {
-        int index = i * m_Channels;
-        m_Pixels[index] = Linear(static_cast<float>(out[index]) / 255.f);
-        m_Pixels[index + 1] = Linear(static_cast<float>(out[index + 1]) / 255.f);
-        m_Pixels[index + 2] = Linear(static_cast<float>(out[index + 2]) / 255.f);
-        m_Pixels[index + 3] = Linear(static_cast<float>(out[index + 3]) / 255.f);
-    }
+    /* Alpha is the last of the RGBA channels */
+    Transfer::Decode(ColorSpace::sRGB, out.data(), m_Pixels.data(), m_Width * m_Height, m_Channels, m_Channels - 1);
 }
 
 const std::map<std::string, std::string> TurboJpegReader::Metadata() const
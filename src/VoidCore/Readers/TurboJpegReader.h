@@ -109,9 +109,6 @@ private: /* Members */
     ColorSpace m_InputColorSpace;
     std::vector<float> m_Pixels;
     std::vector<unsigned char> m_TPixels;
-
-private: /* Methods */
-    inline static float Linear(float pixel) { return (pixel <= 0.04045f) ? pixel / 12.92f : powf((pixel + 0.055f) / 1.055f, 2.4f); }
 };
 
 VOID_NAMESPACE_CLOSE
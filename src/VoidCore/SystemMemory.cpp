@@ -0,0 +1,168 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+/* STD */
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+/* Internal */
+#include "SystemMemory.h"
+
+VOID_NAMESPACE_OPEN
+
+#if defined(__linux__)
+
+/* Mount point of the cgroup (v2) unified hierarchy */
+static const std::string CgroupRoot = "/sys/fs/cgroup";
+
+/**
+ * Returns the path of the cgroup (v2) directory the process belongs to, empty if the process
+ * isn't running under a unified hierarchy
+ */
+static std::string CgroupDirectory()
+{
+    std::ifstream file("/proc/self/cgroup");
+    std::string line;
+
+    /* The unified hierarchy is listed as 0::/path/to/cgroup */
+    while (std::getline(file, line))
+    {
+        if (line.rfind("0::", 0) == 0)
+            return CgroupRoot + line.substr(3);
+    }
+
+    return std::string();
+}
+
+/**
+ * Reads a single byte value from a cgroup file, returns false if the file isn't present,
+ * the value is not limited (max) or can't be parsed
+ */
+static bool ReadBytes(const std::string& path, std::size_t& value)
+{
+    std::ifstream file(path);
+    std::string token;
+
+    if (!(file >> token) || token == "max")
+        return false;
+
+    /* Not throwing on what can't be parsed, the limit is just treated as absent */
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long bytes = std::strtoull(token.c_str(), &end, 10);
+
+    if (end == token.c_str() || *end != '\0' || errno == ERANGE)
+        return false;
+
+    value = static_cast<std::size_t>(bytes);
+    return true;
+}
+
+/**
+ * Returns the value of the key from /proc/meminfo in bytes, 0 if the key isn't present
+ */
+static std::size_t MemInfo(const std::string& key)
+{
+    std::ifstream file("/proc/meminfo");
+    std::string name;
+    std::size_t kilobytes = 0;
+    std::string unit;
+
+    /* Lines are in the form of -> MemAvailable:   12345678 kB */
+    while (file >> name >> kilobytes)
+    {
+        std::getline(file, unit);
+
+        if (name == key)
+            return kilobytes * 1024;
+    }
+
+    return 0;
+}
+
+/**
+ * Reads the avg10 value of the some line from a PSI file, returns false if it isn't available
+ * or can't be parsed
+ */
+static bool ReadPressure(const std::string& path, double& value)
+{
+    std::ifstream file(path);
+    std::string line;
+
+    /* some avg10=0.00 avg60=0.00 avg300=0.00 total=0 */
+    while (std::getline(file, line))
+    {
+        std::size_t pos = line.find("avg10=");
+
+        if (line.rfind("some", 0) != 0 || pos == std::string::npos)
+            continue;
+
+        const char* start = line.c_str() + pos + 6;
+        char* end = nullptr;
+        errno = 0;
+        double pressure = std::strtod(start, &end);
+
+        if (end == start || errno == ERANGE)
+            return false;
+
+        value = pressure;
+        return true;
+    }
+
+    return false;
+}
+
+#endif // __linux__
+
+MemoryState SystemMemory::Query()
+{
+    MemoryState state;
+
+    #if defined(_WIN32)
+    MEMORYSTATUSEX memStatus;
+    memStatus.dwLength = sizeof(memStatus);
+
+    if (!GlobalMemoryStatusEx(&memStatus))
+        return state;
+
+    state.total = static_cast<std::size_t>(memStatus.ullTotalPhys);
+    state.available = static_cast<std::size_t>(memStatus.ullAvailPhys);
+    #elif defined(__linux__)
+    state.total = MemInfo("MemTotal:");
+    state.available = MemInfo("MemAvailable:");
+
+    const std::string cgroup = CgroupDirectory();
+
+    /**
+     * The effective limit is the lowest one along the hierarchy, the process cgroup itself is often
+     * left unlimited (max) while a parent (a slice or the container) is what's limited, each of the
+     * limited cgroups also bounds what is available by its own usage
+     */
+    for (std::string dir = cgroup; dir.size() > CgroupRoot.size(); dir = dir.substr(0, dir.rfind('/')))
+    {
+        std::size_t limit = 0, current = 0;
+
+        /* The cgroup limit takes precedence when it is lower than what the system has to offer */
+        if (ReadBytes(dir + "/memory.max", limit) && ReadBytes(dir + "/memory.current", current))
+        {
+            state.total = std::min(state.total, limit);
+            state.available = std::min(state.available, limit > current ? limit - current : 0);
+        }
+    }
+
+    /* Pressure of the cgroup is what matters to the process, the system wide one is the fallback */
+    if (cgroup.empty() || !ReadPressure(cgroup + "/memory.pressure", state.pressure))
+        ReadPressure("/proc/pressure/memory", state.pressure);
+    #endif
+
+    return state;
+}
+
+VOID_NAMESPACE_CLOSE
@@ -0,0 +1,48 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#ifndef _VOID_SYSTEM_MEMORY_H
+#define _VOID_SYSTEM_MEMORY_H
+
+/* STD */
+#include <cstddef>
+
+/* Internal */
+#include "Definition.h"
+
+VOID_NAMESPACE_OPEN
+
+/**
+ * @brief Snapshot of the memory state as seen by the current process.
+ */
+struct MemoryState
+{
+    /* Memory the process is allowed to use, the lower of the physical memory and the cgroup limit */
+    std::size_t total = 0;
+    /* Memory which can still be allocated before hitting the limit */
+    std::size_t available = 0;
+    /* Percentage of time (over the last 10 seconds) tasks were stalled on memory, 0 when unavailable */
+    double pressure = 0.0;
+
+    inline bool Valid() const { return total > 0; }
+};
+
+class VOID_API SystemMemory
+{
+public:
+    /**
+     * @brief Queries the current memory state of the system.
+     *
+     * On Linux this takes into account the cgroup v2 limits (memory.max and memory.current) of the cgroup
+     * the process runs in and each of its parents along with /proc/meminfo, the pressure is read from PSI (memory.pressure of the
+     * cgroup or /proc/pressure/memory).
+     * On Windows the physical memory status is used, pressure is not reported.
+     *
+     * @return MemoryState The state, which is invalid (total = 0) if it could not be determined on the platform.
+     */
+    static MemoryState Query();
+};
+
+VOID_NAMESPACE_CLOSE
+
+#endif // _VOID_SYSTEM_MEMORY_H
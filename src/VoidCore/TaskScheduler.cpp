@@ -0,0 +1,131 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+/* STD */
+#include <algorithm>
+
+/* Internal */
+#include "TaskScheduler.h"
+
+VOID_NAMESPACE_OPEN
+
+TaskScheduler::TaskScheduler()
+    : m_Stop(false)
+{
+    /* The thread submitting the work always runs tasks as well, so one less worker than the cores */
+    const std::size_t count = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+    m_Workers.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        m_Workers.emplace_back(&TaskScheduler::Run, this);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        m_Stop = true;
+    }
+
+    m_Submitted.notify_all();
+
+    for (std::thread& worker : m_Workers)
+        worker.join();
+}
+
+TaskScheduler& TaskScheduler::Instance()
+{
+    static TaskScheduler instance;
+    return instance;
+}
+
+void TaskScheduler::ParallelFor(std::size_t count, const std::function<void(std::size_t)>& task)
+{
+    if (!count)
+        return;
+
+    /* Nothing to share */
+    if (count == 1 || m_Workers.empty())
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            task(i);
+        return;
+    }
+
+    std::shared_ptr<Work> work = std::make_shared<Work>();
+    work->task = &task;
+    work->count = count;
+    work->next = 0;
+    work->completed = 0;
+
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        m_Pending.push_back(work);
+    }
+
+    /* Only as many workers as there are tasks apart from what this thread picks up */
+    if (count - 1 >= m_Workers.size())
+        m_Submitted.notify_all();
+    else
+    {
+        for (std::size_t i = 0; i < count - 1; ++i)
+            m_Submitted.notify_one();
+    }
+
+    Execute(*work);
+
+    /* Wait for the tasks which were picked up by the workers */
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    /* All tasks have been handed out, so nobody needs to pick this up anymore */
+    auto it = std::find(m_Pending.begin(), m_Pending.end(), work);
+    if (it != m_Pending.end())
+        m_Pending.erase(it);
+
+    m_Completed.wait(lock, [&work]() -> bool { return work->completed.load() == work->count; });
+}
+
+void TaskScheduler::Run()
+{
+    for (;;)
+    {
+        std::shared_ptr<Work> work;
+
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Submitted.wait(lock, [this]() -> bool { return m_Stop || !m_Pending.empty(); });
+
+            if (m_Stop)
+                return;
+
+            work = m_Pending.front();
+
+            /* Rotate so that the workers spread across the pending work rather than all helping the oldest */
+            m_Pending.pop_front();
+            if (work->next.load() < work->count)
+                m_Pending.push_back(work);
+        }
+
+        if (Execute(*work))
+        {
+            /* Lock to ensure the submitting thread is either waiting or is yet to check for completion */
+            std::lock_guard<std::mutex> guard(m_Mutex);
+            m_Completed.notify_all();
+        }
+    }
+}
+
+bool TaskScheduler::Execute(Work& work)
+{
+    bool last = false;
+
+    for (std::size_t i = work.next++; i < work.count; i = work.next++)
+    {
+        (*work.task)(i);
+        last = ++work.completed == work.count;
+    }
+
+    return last;
+}
+
+VOID_NAMESPACE_CLOSE
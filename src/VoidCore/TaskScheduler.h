@@ -0,0 +1,95 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#ifndef _VOID_TASK_SCHEDULER_H
+#define _VOID_TASK_SCHEDULER_H
+
+/* STD */
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Internal */
+#include "Definition.h"
+
+VOID_NAMESPACE_OPEN
+
+/**
+ * @brief A process wide pool of worker threads to run data parallel work on.
+ *
+ * Work is submitted as a range of independent tasks (e.g. tiles of an image) which are picked up
+ * by the workers as well as the thread that submitted the work, the submitting thread only returns
+ * once all of the tasks have been run.
+ * As every caller shares the same workers, multiple threads submitting work at the same time (cache threads
+ * evaluating frames) don't multiply the number of threads, the idle workers help whichever work is pending
+ * while each caller keeps working on its own.
+ */
+class VOID_API TaskScheduler
+{
+    TaskScheduler();
+public:
+    static TaskScheduler& Instance();
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler(TaskScheduler&&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+    /**
+     * @brief Runs task(i) for each i in [0, count) across the workers and the calling thread.
+     * Returns once all of the tasks have completed.
+     *
+     * @param count Number of tasks.
+     * @param task The task to run for an index.
+     */
+    void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    /**
+     * @brief Returns the number of worker threads (excluding any thread submitting work).
+     */
+    inline std::size_t Workers() const { return m_Workers.size(); }
+
+private: /* Members */
+    /**
+     * A range of tasks submitted together
+     * Indices are handed out to whoever picks the work up and it's done when all of them have completed
+     */
+    struct Work
+    {
+        const std::function<void(std::size_t)>* task;
+        std::size_t count;
+        std::atomic<std::size_t> next;
+        std::atomic<std::size_t> completed;
+    };
+
+    std::vector<std::thread> m_Workers;
+    std::deque<std::shared_ptr<Work>> m_Pending;
+
+    std::mutex m_Mutex;
+    /* Workers wait on this for work to be submitted */
+    std::condition_variable m_Submitted;
+    /* Submitting threads wait on this for their work to complete */
+    std::condition_variable m_Completed;
+
+    bool m_Stop;
+
+private: /* Methods */
+    void Run();
+
+    /**
+     * Runs the tasks of the work till there aren't any left to be picked up
+     * returns true if this completed the last of the tasks
+     */
+    bool Execute(Work& work);
+};
+
+VOID_NAMESPACE_CLOSE
+
+#endif // _VOID_TASK_SCHEDULER_H
@@ -0,0 +1,284 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+/* STD */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+/* Internal */
+#include "Transfer.h"
+
+VOID_NAMESPACE_OPEN
+
+namespace Transfer {
+
+namespace {
+
+    /**
+     * Curves which have tables, colorspaces without a transfer function share the linear one
+     */
+    enum Curve
+    {
+        LinearCurve,
+        SRGBCurve,
+        Rec709Curve,
+        LogCCurve,
+        CurveCount
+    };
+
+    /* Supported integer depths */
+    static const int s_Depths[] = {8, 10, 12, 16};
+    static const std::size_t s_DepthCount = 4;
+
+    /**
+     * Encoding tables are indexed by the upper 16 bits of the (positive) float i.e. its exponent and 7 bits of the
+     * mantissa, which keeps the same relative precision across the whole range, the lower bits interpolate between
+     * two entries. The last entry is the bucket of infinity which the input is always clamped to be below.
+     */
+    static const std::size_t s_EncodeSize = (0x7F800000u >> 16) + 1;
+
+    /* ARRI LogC3 (EI 800) */
+    static const float s_LogCCut = 0.010591f;
+    static const float s_LogCA = 5.555556f;
+    static const float s_LogCB = 0.052272f;
+    static const float s_LogCC = 0.247190f;
+    static const float s_LogCD = 0.385537f;
+    static const float s_LogCE = 5.367655f;
+    static const float s_LogCF = 0.092809f;
+
+    Curve CurveOf(const ColorSpace& colorspace)
+    {
+        switch (colorspace)
+        {
+            case ColorSpace::sRGB: return SRGBCurve;
+            case ColorSpace::Rec709: return Rec709Curve;
+            case ColorSpace::LogC: return LogCCurve;
+            default: return LinearCurve;
+        }
+    }
+
+    std::size_t DepthOf(int bits)
+    {
+        for (std::size_t i = 0; i < s_DepthCount; ++i)
+        {
+            if (s_Depths[i] == bits)
+                return i;
+        }
+
+        /* 16 bits */
+        return s_DepthCount - 1;
+    }
+
+    float ToLinear(Curve curve, float value)
+    {
+        switch (curve)
+        {
+            case SRGBCurve:
+                return (value <= 0.04045f) ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+            case Rec709Curve:
+                return (value < 0.081f) ? value / 4.5f : std::pow((value + 0.099f) / 1.099f, 1.f / 0.45f);
+            case LogCCurve:
+                return (value > s_LogCE * s_LogCCut + s_LogCF)
+                    ? (std::pow(10.f, (value - s_LogCD) / s_LogCC) - s_LogCB) / s_LogCA
+                    : (value - s_LogCF) / s_LogCE;
+            case LinearCurve:
+            default:
+                return value;
+        }
+    }
+
+    float FromLinear(Curve curve, float value)
+    {
+        switch (curve)
+        {
+            case SRGBCurve:
+                return (value <= 0.0031308f) ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+            case Rec709Curve:
+                return (value < 0.018f) ? value * 4.5f : 1.099f * std::pow(value, 0.45f) - 0.099f;
+            case LogCCurve:
+                return (value > s_LogCCut)
+                    ? s_LogCC * std::log10(s_LogCA * value + s_LogCB) + s_LogCD
+                    : s_LogCE * value + s_LogCF;
+            case LinearCurve:
+            default:
+                return value;
+        }
+    }
+
+    /**
+     * Tables are built the first time they're needed, from whichever thread needs them first
+     */
+    struct Tables
+    {
+        std::once_flag decodeBuilt[CurveCount][s_DepthCount];
+        std::vector<float> decode[CurveCount][s_DepthCount];
+
+        std::once_flag encodeBuilt[CurveCount];
+        std::vector<float> encode[CurveCount];
+
+        /* Largest linear value which gets encoded, anything above encodes to 1 */
+        float upper[CurveCount];
+    };
+
+    Tables& Instance()
+    {
+        static Tables tables;
+        return tables;
+    }
+
+    const float* DecodeTable(Curve curve, std::size_t depth)
+    {
+        Tables& tables = Instance();
+
+        std::call_once(tables.decodeBuilt[curve][depth], [&tables, curve, depth]() -> void
+        {
+            const std::size_t size = std::size_t(1) << s_Depths[depth];
+            const float max = static_cast<float>(size - 1);
+
+            std::vector<float>& table = tables.decode[curve][depth];
+            table.resize(size);
+
+            for (std::size_t i = 0; i < size; ++i)
+                table[i] = ToLinear(curve, i / max);
+        });
+
+        return tables.decode[curve][depth].data();
+    }
+
+    const float* EncodeTable(Curve curve, float& upper)
+    {
+        Tables& tables = Instance();
+
+        std::call_once(tables.encodeBuilt[curve], [&tables, curve]() -> void
+        {
+            std::vector<float>& table = tables.encode[curve];
+            table.resize(s_EncodeSize);
+
+            for (std::size_t i = 0; i < s_EncodeSize; ++i)
+            {
+                const std::uint32_t bits = static_cast<std::uint32_t>(i) << 16;
+                float value;
+                std::memcpy(&value, &bits, sizeof(float));
+
+                table[i] = std::clamp(FromLinear(curve, value), 0.f, 1.f);
+            }
+
+            tables.upper[curve] = ToLinear(curve, 1.f);
+        });
+
+        upper = tables.upper[curve];
+        return tables.encode[curve].data();
+    }
+
+    /**
+     * Encoded value (0 - 1) for a linear value through the table
+     */
+    inline float Lookup(Curve curve, const float* table, float upper, float value)
+    {
+        /* Non positive values are on the linear segment of each of the curves (NaNs are taken as 0) */
+        if (!(value > 0.f))
+            return (value < 0.f) ? std::clamp(FromLinear(curve, value), 0.f, 1.f) : FromLinear(curve, 0.f);
+
+        if (value >= upper)
+            return 1.f;
+
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(float));
+
+        const std::uint32_t index = bits >> 16;
+        const float t = (bits & 0xFFFF) * (1.f / 65536.f);
+
+        return table[index] + (table[index + 1] - table[index]) * t;
+    }
+
+    template <typename T>
+    void DecodePixels(Curve curve, std::size_t depth, const T* in, float* out, std::size_t pixels, std::size_t channels, int alpha)
+    {
+        const float* table = DecodeTable(curve, depth);
+        const std::size_t count = pixels * channels;
+        const std::size_t max = (std::size_t(1) << s_Depths[depth]) - 1;
+
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = table[std::min<std::size_t>(in[i], max)];
+
+        /* Alpha is only normalized */
+        if (alpha >= 0 && static_cast<std::size_t>(alpha) < channels && curve != LinearCurve)
+        {
+            const float scale = 1.f / max;
+
+            for (std::size_t i = alpha; i < count; i += channels)
+                out[i] = std::min<std::size_t>(in[i], max) * scale;
+        }
+    }
+
+    template <typename T>
+    void EncodePixels(Curve curve, int bits, const float* in, T* out, std::size_t pixels, std::size_t channels, int alpha)
+    {
+        const std::size_t count = pixels * channels;
+        const float max = static_cast<float>((std::size_t(1) << s_Depths[DepthOf(bits)]) - 1);
+
+        if (curve == LinearCurve)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = static_cast<T>(std::clamp(in[i], 0.f, 1.f) * max + 0.5f);
+
+            return;
+        }
+
+        float upper;
+        const float* table = EncodeTable(curve, upper);
+
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = static_cast<T>(Lookup(curve, table, upper, in[i]) * max + 0.5f);
+
+        /* Alpha is only quantized */
+        if (alpha >= 0 && static_cast<std::size_t>(alpha) < channels)
+        {
+            for (std::size_t i = alpha; i < count; i += channels)
+                out[i] = static_cast<T>(std::clamp(in[i], 0.f, 1.f) * max + 0.5f);
+        }
+    }
+
+} // namespace
+
+float ToLinear(const ColorSpace& colorspace, float value)
+{
+    return ToLinear(CurveOf(colorspace), value);
+}
+
+float FromLinear(const ColorSpace& colorspace, float value)
+{
+    return FromLinear(CurveOf(colorspace), value);
+}
+
+const float* DecodeTable(const ColorSpace& colorspace, int bits)
+{
+    return DecodeTable(CurveOf(colorspace), DepthOf(bits));
+}
+
+void Decode(const ColorSpace& colorspace, const std::uint8_t* in, float* out, std::size_t pixels, std::size_t channels, int alpha)
+{
+    DecodePixels(CurveOf(colorspace), DepthOf(8), in, out, pixels, channels, alpha);
+}
+
+void Decode(const ColorSpace& colorspace, const std::uint16_t* in, int bits, float* out, std::size_t pixels, std::size_t channels, int alpha)
+{
+    DecodePixels(CurveOf(colorspace), DepthOf(bits), in, out, pixels, channels, alpha);
+}
+
+void Encode(const ColorSpace& colorspace, const float* in, std::uint8_t* out, std::size_t pixels, std::size_t channels, int alpha)
+{
+    EncodePixels(CurveOf(colorspace), 8, in, out, pixels, channels, alpha);
+}
+
+void Encode(const ColorSpace& colorspace, const float* in, std::uint16_t* out, int bits, std::size_t pixels, std::size_t channels, int alpha)
+{
+    EncodePixels(CurveOf(colorspace), bits, in, out, pixels, channels, alpha);
+}
+
+} // namespace Transfer
+
+VOID_NAMESPACE_CLOSE
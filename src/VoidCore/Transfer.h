@@ -0,0 +1,83 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#ifndef _VOID_TRANSFER_H
+#define _VOID_TRANSFER_H
+
+/* STD */
+#include <cstddef>
+#include <cstdint>
+
+/* Internal */
+#include "Definition.h"
+#include "Colorspace.h"
+
+VOID_NAMESPACE_OPEN
+
+/**
+ * @brief Transfer functions of the colorspaces between their encoded values and linear light.
+ *
+ * Conversions of integer pixels are lookups into tables which are built once (on first use) from the
+ * definitions below, so any reader or writer decoding/encoding the same values gets identical results.
+ * The same definitions (and constants) are used by the viewer's shader to linearize the textures.
+ *
+ * Colorspaces without a transfer function of their own (Linear, ACEScg, Custom) only get normalized.
+ * Integer depths of 8, 10, 12 and 16 bits are supported, any other depth is treated as 16 bits.
+ */
+namespace Transfer {
+
+    /**
+     * @brief Linear value for an encoded value (0 - 1) of the colorspace.
+     */
+    VOID_API float ToLinear(const ColorSpace& colorspace, float value);
+
+    /**
+     * @brief Encoded value (0 - 1) of the colorspace for a linear value.
+     */
+    VOID_API float FromLinear(const ColorSpace& colorspace, float value);
+
+    /**
+     * @brief Returns the table of linear values for each of the (2 ^ bits) code values of the colorspace.
+     */
+    VOID_API const float* DecodeTable(const ColorSpace& colorspace, int bits);
+
+    /**
+     * @brief Decodes interleaved integer pixels of the colorspace to linear floats.
+     *
+     * @param colorspace Colorspace the pixels are encoded in.
+     * @param in Encoded pixels.
+     * @param out Linear pixels, pixels * channels floats.
+     * @param pixels Number of pixels.
+     * @param channels Number of channels in each pixel.
+     * @param alpha Index of the alpha channel which is only normalized, -1 if there isn't one.
+     */
+    VOID_API void Decode(const ColorSpace& colorspace, const std::uint8_t* in, float* out, std::size_t pixels, std::size_t channels, int alpha = -1);
+
+    /**
+     * @brief Decodes interleaved integer pixels (of the provided depth in bits) of the colorspace to linear floats.
+     */
+    VOID_API void Decode(const ColorSpace& colorspace, const std::uint16_t* in, int bits, float* out, std::size_t pixels, std::size_t channels, int alpha = -1);
+
+    /**
+     * @brief Encodes interleaved linear float pixels into 8 bit code values of the colorspace.
+     * Values are clamped to 0 - 1 and rounded to the nearest code value.
+     *
+     * @param colorspace Colorspace to encode the pixels in.
+     * @param in Linear pixels.
+     * @param out Encoded pixels, pixels * channels values.
+     * @param pixels Number of pixels.
+     * @param channels Number of channels in each pixel.
+     * @param alpha Index of the alpha channel which is only quantized, -1 if there isn't one.
+     */
+    VOID_API void Encode(const ColorSpace& colorspace, const float* in, std::uint8_t* out, std::size_t pixels, std::size_t channels, int alpha = -1);
+
+    /**
+     * @brief Encodes interleaved linear float pixels into code values (of the provided depth in bits) of the colorspace.
+     */
+    VOID_API void Encode(const ColorSpace& colorspace, const float* in, std::uint16_t* out, int bits, std::size_t pixels, std::size_t channels, int alpha = -1);
+
+} // namespace Transfer
+
+VOID_NAMESPACE_CLOSE
+
+#endif // _VOID_TRANSFER_H
@@ -51,6 +51,21 @@ namespace Tools {
         return false;
     }
 
+    std::size_t replace_all(std::string& text, const std::string& placeholder, const std::string& replacement)
+    {
+        std::size_t count = 0;
+        std::size_t pos = text.find(placeholder);
+
+        while (pos != std::string::npos)
+        {
+            text.replace(pos, placeholder.size(), replacement);
+            pos = text.find(placeholder, pos + replacement.size());
+            ++count;
+        }
+
+        return count;
+    }
+
     template <typename Ty>
     int index_of(const std::vector<Ty>& vec, const Ty& value)
     {
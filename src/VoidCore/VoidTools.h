@@ -24,6 +24,15 @@ namespace Tools {
     inline VOID_API void to_lower(std::string& in) { std::transform(in.begin(), in.end(), in.begin(), [](unsigned char c) { return std::tolower(c); }); }
 
     VOID_API bool find_replace(std::string& text, const std::string& placeholder, const std::string& replacement);
+    /**
+     * Replaces every occurence of the placeholder, returns the number of replacements made
+     */
+    VOID_API std::size_t replace_all(std::string& text, const std::string& placeholder, const std::string& replacement);
+
+    /**
+     * Combines the hash into the seed, the order in which hashes are combined matters
+     */
+    inline VOID_API void hash_combine(std::size_t& seed, std::size_t hash) { seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2); }
 
     template <typename Ty>
     int index_of(const std::vector<Ty>& vec, const Ty& value);
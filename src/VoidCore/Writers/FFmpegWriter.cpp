@@ -15,6 +15,7 @@ extern "C" {
 /* Internal */
 #include "FFmpegWriter.h"
 #include "VoidCore/Logging.h"
+#include "VoidCore/Transfer.h"
 
 VOID_NAMESPACE_OPEN
 
@@ -307,8 +308,8 @@ void FFmpegWriter::CopyBuffer(const uint16_t* src, uint8_t* dest, std::size_t si
 
 void FFmpegWriter::CopyBuffer(const float* src, uint8_t* dest, std::size_t size)
 {
-    for (int i = 0; i < static_cast<int>(size); ++i)
-        dest[i] = static_cast<uint8_t>(std::clamp(src[i], 0.f, 1.f) * 255.f);
+    /* The buffer is already in the output colorspace, only gets quantized */
+    Transfer::Encode(ColorSpace::Linear, src, dest, size, 1);
 }
 
 VOID_NAMESPACE_CLOSE
@@ -1,6 +1,7 @@
 // Copyright (c) 2025 waaake
 // Licensed under the MIT License
 
+/* Internal */
 #include "Effects.h"
 #include "VoidCore/Logging.h"
 
@@ -16,11 +17,6 @@ Effect::Effect(ImageOp* iop, const std::string& name, QObject* parent)
 
 Effect::~Effect()
 {
-    if (m_Operator)
-    {
-        delete m_Operator;
-        m_Operator = nullptr;
-    }
 }
 
 bool Effect::SetValue(const std::string& param, ValueType value)
@@ -57,6 +53,11 @@ const ValueType& Effect::Value(const std::string& param) const
     return invalid;
 }
 
+std::size_t Effect::Hash() const
+{
+    return m_Operator->Snapshot().hash;
+}
+
 void Effect::SetEnabled(bool enable)
 {
     m_Enabled = enable;
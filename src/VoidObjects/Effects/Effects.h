@@ -51,16 +51,28 @@ public:
     void SetEnabled(bool enable);
 
     Param* GetParam(const std::string& name) const { return m_Operator->GetParam(name); }
-    ImageOp* ImageOperator() { return m_Operator; }
+    ImageOp* ImageOperator() { return m_Operator.get(); }
+
+    /**
+     * @brief Returns the shared operator, which stays valid for whoever holds on to it even after the effect is removed.
+     * e.g. while a frame is being evaluated with it on a cache thread.
+     */
+    SharedImageOp Operator() const { return m_Operator; }
 
     const std::vector<Param*>& Params() const { return m_Operator->Params(); }
 
+    /**
+     * @brief Returns a hash of the effect along with the current values of its params.
+     * Any change in the values results in a different hash, this is the hash of the snapshot of the params.
+     */
+    std::size_t Hash() const;
+
 signals:
     void updated();
     void valueChanged(const Param*);
 
 private:
-    ImageOp* m_Operator;
+    SharedImageOp m_Operator;
     std::string m_Name;
     bool m_Enabled;
 };
@@ -8,6 +8,7 @@
 #include "MediaClip.h"
 #include "VoidCore/Logging.h"
 #include "VoidCore/Processors/ImageProcessor.h"
+#include "VoidCore/VoidTools.h"
 #include "VoidObjects/Core/Threads.h"
 #include "VoidObjects/Effects/Bridge.h"
 #include "VoidCore/Profiler.h"
@@ -266,8 +267,9 @@ Effect* MediaClip::CreateEffect(const std::string& type)
         VOID_LOG_INFO("Effect Created -> {}", effect->Name());
         m_Effects.push_back(effect);
 
-        // For every effect that gets updated, the media will be set dirty
-        connect(effect, &Effect::updated, this, [this]() -> void { SetDirty(true); });
+        // For every effect that gets updated, the media will be set dirty and the chain taken again
+        connect(effect, &Effect::updated, this, [this]() -> void { m_Chain = nullptr; SetDirty(true); });
+        m_Chain = nullptr;
         SetDirty(true);
         return effect;
     }
@@ -289,6 +291,7 @@ bool MediaClip::RemoveEffect(const std::string& name)
             effect = nullptr;
 
             m_Effects.erase(m_Effects.begin() + i);
+            m_Chain = nullptr;
             return true;
         }
     }
@@ -306,6 +309,7 @@ void MediaClip::ClearEffects()
     }
 
     m_Effects.clear();
+    m_Chain = nullptr;
 }
 
 std::vector<int> MediaClip::AnnotatedFrames() const
@@ -345,6 +349,12 @@ void MediaClip::UncacheFrame(v_frame_t frame)
     // emit frameUncached(frame);
 }
 
+void MediaClip::ReleaseEvaluated(v_frame_t frame)
+{
+    if (InRange(frame) && Contains(frame))
+        m_Mediaframes.at(frame - m_FirstFrame).ReleaseEvaluated();
+}
+
 void MediaClip::ClearCache()
 {
     // Mark the underlying frames as dirty only if this has effects added to it
@@ -552,30 +562,162 @@ void MediaClip::Deserialize(std::istream& in)
     }
 }
 
-SharedPixels MediaClip::Evaluate(v_frame_t frame)
+SharedEffectChain MediaClip::Chain()
 {
-    Frame* f = FramePtr(frame);
+    if (m_Chain)
+        return m_Chain;
+
+    std::shared_ptr<EffectChain> chain = std::make_shared<EffectChain>();
 
-    if (f->Dirty())
+    // Any effect which can't be drawn means the rest of the chain is evaluated on the CPU
+    bool drawable = true;
+
+    for (Effect* effect : m_Effects)
     {
-        // Generates a new copy everytime :(
-        SharedPixels image = f->Writable();
+        ImageOp* op = effect->ImageOperator();
+
+        if (effect->Enabled() && !op->Geometric() && !op->Drawable())
+            drawable = false;
+    }
 
-        for (auto effect : m_Effects)
+    if (!drawable)
+    {
+        chain->operators.reserve(m_Effects.size());
+        chain->params.reserve(m_Effects.size());
+
+        for (Effect* effect : m_Effects)
         {
-            // Only process the effects that are enabled
-            if (effect->Enabled())
-            {
-                VOID_LOG_INFO("Processing {}", effect->Name());
-                ImageProcessor::Instance().ProcessImage(image, effect->ImageOperator());
-            }
+            // Geometric effects are always left for drawing
+            if (!effect->Enabled() || effect->ImageOperator()->Geometric())
+                continue;
+
+            // The values of the effects are snapshot once for the chain, which is also what the evaluation is keyed against
+            chain->operators.push_back(effect->Operator());
+            chain->params.push_back(effect->ImageOperator()->Snapshot());
+            Tools::hash_combine(chain->key, chain->params.back().hash);
         }
+    }
+
+    m_Chain = chain;
+    return m_Chain;
+}
 
-        f->SetDirty(false);
+SharedPixels MediaClip::Evaluate(v_frame_t frame, std::vector<ImageOp*>& operators)
+{
+    operators.clear();
+
+    const SharedEffectChain chain = Chain();
+
+    // Geometric effects are always left for drawing, the rest only when none of them need to be evaluated
+    for (Effect* effect : m_Effects)
+    {
+        if (effect->Enabled() && (chain->Empty() || effect->ImageOperator()->Geometric()))
+            operators.push_back(effect->ImageOperator());
+    }
+
+    return Evaluate(frame, *chain);
+}
+
+SharedPixels MediaClip::Evaluate(v_frame_t frame, const EffectChain& chain)
+{
+    Frame* f = FramePtr(frame);
+
+    /* Already evaluated with the same effects and values */
+    if (SharedPixels image = f->Evaluated(chain.key, chain.params))
         return image;
+
+    // Nothing gets evaluated here, the original image is what gets drawn
+    if (chain.Empty())
+        return f->Image();
+
+    std::vector<ImageOp*> operators;
+    operators.reserve(chain.operators.size());
+
+    for (const SharedImageOp& op : chain.operators)
+        operators.push_back(op.get());
+
+    // Only the copy of the original is made, reusing the allocation of the earlier evaluation
+    SharedPixels image = f->Writable();
+
+    // All of the effects are evaluated in a single pass over the image, which is only then kept on the frame
+    ImageProcessor::Instance().Process(image, operators, chain.params);
+    f->SetEvaluated(chain.key, chain.params, image);
+
+    return image;
+}
+
+SharedPixels MediaClip::Evaluated(v_frame_t frame, const EffectChain& chain)
+{
+    Frame* f = FramePtr(frame);
+    SharedPixels image = f->Evaluated(chain.key, chain.params);
+
+    return chain.Empty() ? f->Image(false) : image;
+}
+
+SharedEffectChain MediaClip::FullChain()
+{
+    std::shared_ptr<EffectChain> chain = std::make_shared<EffectChain>();
+    chain->operators.reserve(m_Effects.size());
+    chain->params.reserve(m_Effects.size());
+
+    for (Effect* effect : m_Effects)
+    {
+        if (!effect->Enabled())
+            continue;
+
+        chain->operators.push_back(effect->Operator());
+        chain->params.push_back(effect->ImageOperator()->Snapshot());
+        Tools::hash_combine(chain->key, chain->params.back().hash);
+    }
+
+    return chain;
+}
+
+SharedPixels MediaClip::EvaluateCopy(v_frame_t frame, const EffectChain& chain)
+{
+    SharedPixels image = FramePtr(frame)->Copy();
+
+    if (chain.Empty())
+        return image;
+
+    std::vector<ImageOp*> operators;
+    operators.reserve(chain.operators.size());
+
+    for (const SharedImageOp& op : chain.operators)
+        operators.push_back(op.get());
+
+    // Geometric effects are applied in the final pass of the evaluation
+    ImageProcessor::Instance().Process(image, operators, chain.params);
+    return image;
+}
+
+std::size_t MediaClip::EffectsHash() const
+{
+    std::size_t hash = 0;
+
+    for (const Effect* effect : m_Effects)
+    {
+        if (effect->Enabled())
+            Tools::hash_combine(hash, effect->Hash());
+    }
+
+    return hash;
+}
+
+TextureTransform MediaClip::Geometry() const
+{
+    TextureTransform transform;
+
+    for (Effect* effect : m_Effects)
+    {
+        if (effect->Enabled() && effect->ImageOperator()->Geometric())
+        {
+            ImageOp* op = effect->ImageOperator();
+            transform = transform * op->Geometry(op->Snapshot());
+        }
     }
 
-    return f->Image();
+    return transform;
 }
 
 VOID_NAMESPACE_CLOSE
@@ -17,6 +17,7 @@
 
 /* Internal */
 #include "Definition.h"
+#include "Operator.h"
 #include "VoidCore/Media/Media.h"
 #include "VoidObjects/VoidObject.h"
 #include "VoidObjects/Models/TagModel.h"
@@ -30,6 +31,24 @@ typedef std::shared_ptr<MediaClip> SharedMediaClip;
 
 class Effect;
 
+/**
+ * @brief The effects of a media which get evaluated on the CPU along with the values of their params.
+ * The chain is taken on the main thread and can then be evaluated on frames from any thread, the operators are
+ * held on to so the chain stays valid even if the effects are edited or removed meanwhile.
+ */
+struct EffectChain
+{
+    std::vector<SharedImageOp> operators;
+    std::vector<ParamSnapshot> params;
+
+    /* Hash of the params of the operators in order, 0 when there isn't anything to be evaluated */
+    std::size_t key = {0};
+
+    [[nodiscard]] inline bool Empty() const { return operators.empty(); }
+};
+
+typedef std::shared_ptr<const EffectChain> SharedEffectChain;
+
 class VOID_API MediaClip : public VoidObject, public Media
 {
     Q_OBJECT
@@ -73,6 +92,8 @@ public:
 
     void CacheFrame(v_frame_t frame);
     void UncacheFrame(v_frame_t frame);
+    /* Releases the evaluated images of the frame, the original image stays cached */
+    void ReleaseEvaluated(v_frame_t frame);
     void ClearCache();
 
     /* Add Annotation for a Frame */
@@ -121,13 +142,71 @@ public:
     const char* TypeName() const override { return "Media"; }
 
     /**
-     * @brief Evaluates any effects added onto the Media, and returns the modified
-     * image buffer with effect applied on the original image data
-     * 
+     * @brief Returns the chain of effects to be evaluated on the CPU, this is empty if there aren't any effects
+     * or if all of them can be applied while drawing (provide a shader), geometric effects are never a part of it.
+     * The same chain is returned till any of the effects change.
+     */
+    SharedEffectChain Chain();
+
+    /**
+     * @brief Returns the image for the frame along with the operators of the enabled effects if all of them
+     * can be applied while drawing, in which case the image is the original one and changes to
+     * the values of the effects don't need the frame to be evaluated again.
+     * If any of the effects can only be evaluated on the CPU, the image has the chain evaluated and only the geometric
+     * operators are returned, these are always left for drawing so that they never need a copy of the frame.
+     *
+     * @param frame Frame number.
+     * @param operators Filled in with the operators to be applied while drawing, in order.
+     * @return SharedPixels Image Buffer data for rendering.
+     */
+    SharedPixels Evaluate(v_frame_t frame, std::vector<ImageOp*>& operators);
+
+    /**
+     * @brief Evaluates the chain on the frame unless it has already been, the evaluated image is kept on the frame
+     * (and released along with it) and reused till the effects or their values change.
+     * This can be invoked from the cache threads.
+     *
      * @param frame Frame number.
-     * @return SharedPixels Image Buffer data for reading/rendering.
+     * @param chain The chain of effects to evaluate.
+     * @return SharedPixels Evaluated image, the original one if the chain is empty.
      */
-    SharedPixels Evaluate(v_frame_t frame);
+    SharedPixels Evaluate(v_frame_t frame, const EffectChain& chain);
+
+    /**
+     * @brief Returns the image evaluated for the chain, nothing is read or evaluated.
+     *
+     * @param frame Frame number.
+     * @param chain The chain of effects the frame is expected to be evaluated with.
+     * @return SharedPixels Evaluated image, the original one if the chain is empty, nullptr if not yet evaluated.
+     */
+    SharedPixels Evaluated(v_frame_t frame, const EffectChain& chain);
+
+    /**
+     * @brief Returns the chain of all of the enabled effects (geometric ones included) as they are right now.
+     * This is what gets evaluated on the frames which are exported without the viewer.
+     */
+    SharedEffectChain FullChain();
+
+    /**
+     * @brief Evaluates the chain on a copy of the original image.
+     * Nothing gets cached on the frame, so this can be called away from the viewer, e.g. while exporting.
+     *
+     * @param frame Frame number.
+     * @param chain The chain of effects to evaluate, taken on the main thread.
+     * @return SharedPixels Evaluated copy of the image.
+     */
+    SharedPixels EvaluateCopy(v_frame_t frame, const EffectChain& chain);
+
+    /**
+     * @brief Returns a hash of the enabled effects (in order) along with their values.
+     * 0 if there aren't any enabled effects.
+     */
+    std::size_t EffectsHash() const;
+
+    /**
+     * @brief Returns the combined transform of the enabled geometric effects.
+     */
+    TextureTransform Geometry() const;
 
 signals: /* Signals defining any change that has happened */
     /*
@@ -160,6 +239,9 @@ private: /* Members */
     std::unordered_map<v_frame_t, Renderer::SharedAnnotation> m_Annotations;
     std::vector<Effect*> m_Effects;
 
+    /* Chain of the effects evaluated on the CPU, taken again once any of the effects change */
+    SharedEffectChain m_Chain;
+
 private: /* Methods */
     void ReadThumbnail();
     QPixmap DefaultThumbnail();
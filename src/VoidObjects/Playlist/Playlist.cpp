@@ -164,4 +164,16 @@ SharedMediaClip Playlist::PreviousMedia()
     return m_Media->Media(m_Media->index(m_CurrentRow, 0));
 }
 
+SharedMediaClip Playlist::UpcomingMedia() const
+{
+    int row = m_CurrentRow == m_Media->rowCount() - 1 ? 0 : m_CurrentRow + 1;
+    return m_Media->Media(m_Media->index(row, 0));
+}
+
+SharedMediaClip Playlist::PrecedingMedia() const
+{
+    int row = m_CurrentRow == 0 ? m_Media->rowCount() - 1 : m_CurrentRow - 1;
+    return m_Media->Media(m_Media->index(row, 0));
+}
+
 VOID_NAMESPACE_CLOSE
@@ -50,6 +50,12 @@ public:
     SharedMediaClip NextMedia();
     SharedMediaClip PreviousMedia();
 
+    /**
+     * Returns the media which would be played next or previously, without changing the current media
+     */
+    SharedMediaClip UpcomingMedia() const;
+    SharedMediaClip PrecedingMedia() const;
+
     inline void Clear() { m_Media->Clear(); }
 
     inline int Size() const { return static_cast<int>(m_Media->rowCount()); }
@@ -167,6 +167,34 @@ SharedTrackItem PlaybackSequence::GetTrackItem(const int frame) const
     return nullptr;
 }
 
+SharedTrackItem PlaybackSequence::NextTrackItem(const int frame) const
+{
+    /* Same as GetTrackItem, the top track is what gets played */
+    if (!m_VideoTracks.empty() && !m_VideoTracks.back()->IsEmpty())
+        return m_VideoTracks.back()->NextTrackItem(frame);
+
+    return nullptr;
+}
+
+SharedTrackItem PlaybackSequence::PreviousTrackItem(const int frame) const
+{
+    if (!m_VideoTracks.empty() && !m_VideoTracks.back()->IsEmpty())
+        return m_VideoTracks.back()->PreviousTrackItem(frame);
+
+    return nullptr;
+}
+
+bool PlaybackSequence::HasMedia(const SharedMediaClip& media) const
+{
+    for (const SharedPlaybackTrack& track : m_VideoTracks)
+    {
+        if (track->HasMedia(media))
+            return true;
+    }
+
+    return false;
+}
+
 void PlaybackSequence::ClearCache()
 {
     for (SharedPlaybackTrack& track : m_VideoTracks)
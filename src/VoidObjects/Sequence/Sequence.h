@@ -49,6 +49,11 @@ public:
 
     bool HasMedia() const;
 
+    /**
+     * Returns whether the media is played by any item on the video tracks of the sequence
+     */
+    bool HasMedia(const SharedMediaClip& media) const;
+
     /* Update the range of the Sequence */
     void SetRange(int start, int end);
 
@@ -59,6 +64,12 @@ public:
 
     SharedTrackItem GetTrackItem(const int frame) const;
 
+    /**
+     * Returns the track item which comes up after or before the given frame on the top track
+     */
+    SharedTrackItem NextTrackItem(const int frame) const;
+    SharedTrackItem PreviousTrackItem(const int frame) const;
+
 signals: /* Signals denoting actions in the seqeuence */
     void trackAdded();
     void cleared();
@@ -83,6 +83,41 @@ SharedTrackItem TrackMap::At(const int frame) const
     return nullptr;
 }
 
+SharedTrackItem TrackMap::Next(const int frame) const
+{
+    /* The items are keyed on their start frame, the one just after the frame is the next item */
+    std::map<int, SharedTrackItem>::const_iterator it = m_Items.upper_bound(frame);
+    return it != m_Items.end() ? it->second : nullptr;
+}
+
+SharedTrackItem TrackMap::Previous(const int frame) const
+{
+    /* The item which starts before the frame */
+    std::map<int, SharedTrackItem>::const_iterator it = m_Items.lower_bound(frame);
+
+    while (it != m_Items.begin())
+    {
+        --it;
+
+        /* The item could still be holding the frame, in which case the one before is what we're after */
+        if (it->second->EndFrame() < frame)
+            return it->second;
+    }
+
+    return nullptr;
+}
+
+bool TrackMap::Contains(const SharedMediaClip& media) const
+{
+    for (const std::pair<const int, SharedTrackItem>& it : m_Items)
+    {
+        if (it.second->GetMedia() == media)
+            return true;
+    }
+
+    return false;
+}
+
 /* }}} */
 
 PlaybackTrack::PlaybackTrack(QObject* parent)
@@ -51,6 +51,23 @@ public:
      */
     SharedTrackItem At(const int frame) const;
 
+    /**
+     * Returns the first Track Item which starts after the given frame
+     * nullptr if there isn't any item after the frame.
+     */
+    SharedTrackItem Next(const int frame) const;
+
+    /**
+     * Returns the last Track Item which ends before the given frame
+     * nullptr if there isn't any item before the frame.
+     */
+    SharedTrackItem Previous(const int frame) const;
+
+    /**
+     * Returns whether any of the Track Items plays the given media.
+     */
+    bool Contains(const SharedMediaClip& media) const;
+
     inline bool Empty() const { return m_Frames.empty(); }
 
 private: /* Members */
@@ -163,6 +180,9 @@ public:
 
     inline bool IsEmpty() const { return m_Items.Empty(); }
 
+    /* Returns whether the media is played by any item on the track */
+    inline bool HasMedia(const SharedMediaClip& media) const { return m_Items.Contains(media); }
+
     /* Returns the Color associated with the Track */
     inline QColor Color() const { return m_Color; }
 
@@ -180,6 +200,13 @@ public:
      */
     inline SharedTrackItem GetTrackItem(const int frame) const { return m_Items.At(frame); }
 
+    /**
+     * Returns the track item which comes up after or before the given frame in the timeline
+     * this is the item which gets played next at an edit, based on the direction of playback
+     */
+    inline SharedTrackItem NextTrackItem(const int frame) const { return m_Items.Next(frame); }
+    inline SharedTrackItem PreviousTrackItem(const int frame) const { return m_Items.Previous(frame); }
+
     /* The parent of the Track should always be a Sequence, in case it exists inside a Sequence */
     inline PlaybackSequence* Sequence() const { return reinterpret_cast<PlaybackSequence*>(parent()); }
 
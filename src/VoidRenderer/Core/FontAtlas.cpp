@@ -51,6 +51,8 @@ void FontAtlas::Create()
 
 const FChar& FontAtlas::GetChar(char c)
 {
+    std::lock_guard<std::mutex> guard(FontStore::Instance().Mutex());
+
     const auto& it = m_Characters.find(c);
     return it == m_Characters.end() ? AddChar(c) : it->second;
 }
@@ -89,6 +91,9 @@ const FChar& FontAtlas::AddChar(char c)
 
     glPixelStorei(GL_UNPACK_ALIGNMENT, alignment); // Restore
 
+    /* Other contexts of the share group draw with the atlas as well, the glyph needs to reach it before they do */
+    glFlush();
+
     FChar ch;
     ch.uMin = m_PenX / (float)m_Width;
     ch.vMin = m_PenY / (float)m_Height;
@@ -119,13 +124,15 @@ FontStore& FontStore::Instance()
 
 FontAtlas& FontStore::Atlas(int size)
 {
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
     for (FontAtlas& atlas : m_Fonts)
     {
         if (atlas.Size() == size)
             return atlas;
     }
 
-    m_Fonts.push_back(std::move(FontAtlas(FontEngine::Instance().GetStandardFace(), size)));
+    m_Fonts.emplace_back(FontEngine::Instance().GetStandardFace(), size);
     return m_Fonts.back();
 }
 
@@ -5,8 +5,9 @@
 #define _RENDERER_FONT_ATLAS_H
 
 /* STD */
+#include <deque>
+#include <mutex>
 #include <unordered_map>
-#include <vector>
 
 /* Freetype */
 #include <ft2build.h>
@@ -61,6 +62,11 @@ private: /* Methods */
     const FChar& AddChar(char c);
 };
 
+/**
+ * Atlases (and the glyphs in them) are shared by the viewer and the offscreen renderers, which can be drawing
+ * from different threads, so fetching an atlas or a glyph is serialized.
+ * The atlas textures live in the share group of the context which first asked for them.
+ */
 class FontStore
 {
     FontStore() = default;
@@ -76,13 +82,20 @@ public:
      */
     FontAtlas& Atlas(int size);
 
+    /**
+     * Guards the atlases and the font face their glyphs are rendered from
+     */
+    inline std::mutex& Mutex() { return m_Mutex; }
+
 private: /* Members */
+    std::mutex m_Mutex;
+
     /**
-     * Going with a vector over a map, due to the cache benefits
-     * Plus the fonts used is just one at the moment, the varying factor is the size
+     * Going with a deque over a map, the fonts used is just one at the moment, the varying factor is the size
      * which is not more than 10, so all of the fonts can be fetched in a few cache lines
+     * Unlike a vector, atlases handed out stay where they are when another size gets added
      */
-    std::vector<FontAtlas> m_Fonts;
+    std::deque<FontAtlas> m_Fonts;
 };
 
 VOID_NAMESPACE_CLOSE
@@ -0,0 +1,114 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+/* STD */
+#include <cstring>
+
+/* Internal */
+#include "PixelProbe.h"
+
+VOID_NAMESPACE_OPEN
+
+/* Number of reads which can be waiting on the GPU at once */
+static const std::size_t REQUEST_COUNT = 3;
+
+/* Size of a pixel read back, RGBA as floats */
+static const std::size_t PIXEL_SIZE = 4 * sizeof(float);
+
+PixelProbe::PixelProbe()
+    : m_First(0)
+    , m_Count(0)
+{
+}
+
+PixelProbe::~PixelProbe()
+{
+    for (Request& request : m_Requests)
+    {
+        Drop(request);
+        glDeleteBuffers(1, &request.pbo);
+    }
+}
+
+void PixelProbe::Initialize()
+{
+    m_Requests.clear();
+    m_First = 0;
+    m_Count = 0;
+}
+
+void PixelProbe::Read(int x, int y)
+{
+    if (m_Requests.empty())
+    {
+        m_Requests.resize(REQUEST_COUNT);
+
+        for (Request& request : m_Requests)
+        {
+            glGenBuffers(1, &request.pbo);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, request.pbo);
+            glBufferData(GL_PIXEL_PACK_BUFFER, PIXEL_SIZE, nullptr, GL_STREAM_READ);
+        }
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    /* All the buffers are in flight, the oldest read is the least interesting one */
+    if (m_Count == m_Requests.size())
+    {
+        Drop(m_Requests[m_First]);
+        m_First = (m_First + 1) % m_Requests.size();
+        m_Count--;
+    }
+
+    Request& request = m_Requests[(m_First + m_Count) % m_Requests.size()];
+
+    /* With a pack buffer bound, the read is only queued and the pixels land in the buffer once the GPU gets there */
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, request.pbo);
+    glReadPixels(x, y, 1, 1, GL_RGBA, GL_FLOAT, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    request.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_Count++;
+}
+
+bool PixelProbe::Fetch(float (&rgba)[4])
+{
+    bool fetched = false;
+
+    while (m_Count)
+    {
+        Request& request = m_Requests[m_First];
+
+        /* Not waiting on the GPU, but have the commands flushed so the fence does get signalled */
+        GLenum status = glClientWaitSync(request.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            break;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, request.pbo);
+        if (void* optr = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, PIXEL_SIZE, GL_MAP_READ_BIT))
+        {
+            std::memcpy(rgba, optr, PIXEL_SIZE);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            fetched = true;
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        Drop(request);
+        m_First = (m_First + 1) % m_Requests.size();
+        m_Count--;
+    }
+
+    return fetched;
+}
+
+void PixelProbe::Drop(Request& request)
+{
+    if (request.fence)
+    {
+        glDeleteSync(request.fence);
+        request.fence = nullptr;
+    }
+}
+
+VOID_NAMESPACE_CLOSE
@@ -0,0 +1,80 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#ifndef _VOID_PIXEL_PROBE_H
+#define _VOID_PIXEL_PROBE_H
+
+/* GLEW */
+#include <GL/glew.h>
+
+/* STD */
+#include <cstddef>
+#include <vector>
+
+/* Internal */
+#include "Definition.h"
+
+VOID_NAMESPACE_OPEN
+
+/**
+ * @brief Reads back the color of a pixel of the framebuffer without waiting on the GPU.
+ *
+ * The pixel is read into a pixel pack buffer with a fence placed after it, the value is only mapped once the
+ * fence has been signalled (usually by the next frame), so probing the pixel under the mouse doesn't stall
+ * the pipeline while it is still drawing. All the calls are made with the renderer's context current.
+ */
+class PixelProbe
+{
+    /* Buffer a pixel is read into */
+    struct Request
+    {
+        unsigned int pbo = 0;
+        /* Signalled once the pixel has been written to the buffer */
+        GLsync fence = nullptr;
+    };
+
+public:
+    PixelProbe();
+    ~PixelProbe();
+
+    /**
+     * @brief Forgets about the buffers, to be called when the context they belonged to is gone.
+     */
+    void Initialize();
+
+    /**
+     * @brief Queues the read of the pixel from the bound (read) framebuffer.
+     * When all the buffers are still waiting on the GPU, the oldest request is dropped for this one.
+     *
+     * @param x Horizontal position of the pixel in the framebuffer.
+     * @param y Vertical position of the pixel in the framebuffer (from the bottom).
+     */
+    void Read(int x, int y);
+
+    /**
+     * @brief Fetches the color of the most recent read which has completed.
+     *
+     * @param rgba Filled with the color of the pixel.
+     * @return true if a read had completed since the last call, rgba is left as is otherwise.
+     */
+    bool Fetch(float (&rgba)[4]);
+
+    /* Whether there are reads the GPU hasn't completed yet */
+    inline bool Pending() const { return m_Count > 0; }
+
+private: /* Members */
+    std::vector<Request> m_Requests;
+    /* Oldest pending request and the number of pending ones */
+    std::size_t m_First;
+    std::size_t m_Count;
+
+private: /* Methods */
+    /**
+     * Deletes the fence of the request
+     */
+    void Drop(Request& request);
+};
+
+VOID_NAMESPACE_CLOSE
+
+#endif // _VOID_PIXEL_PROBE_H
@@ -0,0 +1,167 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+/* STD */
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+/* GLEW */
+#include <GL/glew.h>
+
+/* Internal */
+#include "TexturePool.h"
+#include "VoidCore/Processors/ImageProcessor.h"
+
+VOID_NAMESPACE_OPEN
+
+/* Number of released textures which are kept to be handed out again */
+static const std::size_t MAX_FREE_TEXTURES = 6;
+
+/* Number of staging buffers used in turns */
+static const std::size_t BUFFER_COUNT = 2;
+
+TexturePool::TexturePool()
+    : m_BufferIndex(0)
+{
+}
+
+TexturePool::~TexturePool()
+{
+    for (const auto& [texture, key] : m_Keys)
+        glDeleteTextures(1, &texture);
+
+    if (!m_Buffers.empty())
+        glDeleteBuffers(static_cast<GLsizei>(m_Buffers.size()), m_Buffers.data());
+}
+
+void TexturePool::Initialize()
+{
+    m_Keys.clear();
+    m_Free.clear();
+
+    m_Buffers.clear();
+    m_Capacities.clear();
+    m_BufferIndex = 0;
+}
+
+unsigned int TexturePool::Acquire(const TextureKey& key)
+{
+    Trim();
+
+    /* Most recently released texture for the key */
+    for (auto it = m_Free.rbegin(); it != m_Free.rend(); ++it)
+    {
+        if (m_Keys[*it] == key)
+        {
+            unsigned int texture = *it;
+            m_Free.erase(std::next(it).base());
+            return texture;
+        }
+    }
+
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, key.internalFormat, key.width, key.height, 0, key.format, key.type, nullptr);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    m_Keys[texture] = key;
+    return texture;
+}
+
+void TexturePool::Release(unsigned int texture)
+{
+    if (texture && m_Keys.find(texture) != m_Keys.end())
+        m_Free.push_back(texture);
+}
+
+void TexturePool::Upload(unsigned int texture, const TextureKey& key, const void* pixels, std::size_t size)
+{
+    if (m_Buffers.empty())
+    {
+        m_Buffers.resize(BUFFER_COUNT);
+        m_Capacities.assign(BUFFER_COUNT, 0);
+        glGenBuffers(static_cast<GLsizei>(BUFFER_COUNT), m_Buffers.data());
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_Buffers[m_BufferIndex]);
+
+    /**
+     * Respecifying the storage lets the driver hand out fresh memory if the buffer is still being read
+     * from for the previous upload, instead of waiting for it
+     */
+    std::size_t& capacity = m_Capacities[m_BufferIndex];
+    capacity = std::max(capacity, size);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+
+    m_BufferIndex = (m_BufferIndex + 1) % m_Buffers.size();
+
+    if (void* iptr = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT))
+    {
+        std::memcpy(iptr, pixels, size);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        /* Rows of the downscaled images aren't necessarily aligned to 4 bytes */
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, key.width, key.height, key.format, key.type, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void TexturePool::Load(const SharedPixels& image, unsigned int& texture, TextureKey& key, int factor)
+{
+    const TextureKey current(image, factor);
+
+    if (!texture || current != key)
+    {
+        Release(texture);
+        texture = Acquire(current);
+        key = current;
+    }
+
+    if (factor > 1)
+    {
+        int width, height;
+        if (ImageProcessor::Instance().Downscale(image, factor, m_Scaled, width, height))
+            Upload(texture, current, m_Scaled.data(), m_Scaled.size());
+    }
+    else
+        Upload(texture, current, image->Pixels(), image->FrameSize());
+}
+
+void TexturePool::Clear()
+{
+    for (unsigned int texture : m_Free)
+    {
+        glDeleteTextures(1, &texture);
+        m_Keys.erase(texture);
+    }
+
+    m_Free.clear();
+}
+
+void TexturePool::Trim()
+{
+    while (m_Free.size() > MAX_FREE_TEXTURES)
+    {
+        unsigned int texture = m_Free.front();
+        m_Free.pop_front();
+
+        glDeleteTextures(1, &texture);
+        m_Keys.erase(texture);
+    }
+}
+
+VOID_NAMESPACE_CLOSE
@@ -0,0 +1,132 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#ifndef _VOID_TEXTURE_POOL_H
+#define _VOID_TEXTURE_POOL_H
+
+/* STD */
+#include <cstddef>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+/* Internal */
+#include "Definition.h"
+#include "PixReader.h"
+
+VOID_NAMESPACE_OPEN
+
+/**
+ * @brief Describes the storage of a texture, textures with the same key are interchangeable.
+ */
+struct TextureKey
+{
+    int width = 0;
+    int height = 0;
+    unsigned int internalFormat = 0;
+    unsigned int format = 0;
+    unsigned int type = 0;
+
+    TextureKey() = default;
+
+    /**
+     * Storage for the image, downscaled by the factor
+     */
+    explicit TextureKey(const SharedPixels& image, int factor = 1)
+        : width((image->Width() + factor - 1) / factor)
+        , height((image->Height() + factor - 1) / factor)
+        , internalFormat(image->GLInternalFormat())
+        , format(image->GLFormat())
+        , type(image->GLType())
+    {
+    }
+
+    inline bool operator==(const TextureKey& other) const
+    {
+        return width == other.width && height == other.height && internalFormat == other.internalFormat
+            && format == other.format && type == other.type;
+    }
+
+    inline bool operator!=(const TextureKey& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Textures and staging (pixel unpack) buffers shared by the render layers.
+ *
+ * Textures are handed out for a key and returned to the pool when the layer no longer needs them (e.g. the image
+ * changed in size), a few of the returned ones are kept around, so switching between media of different resolutions
+ * reuses textures already allocated for them instead of reallocating one on every switch.
+ * All the calls which need the GL (Acquire and Upload) are made with the renderer's context current.
+ */
+class TexturePool
+{
+public:
+    TexturePool();
+    ~TexturePool();
+
+    /**
+     * @brief Forgets about all the textures and buffers, to be called when the context they belonged to is gone.
+     */
+    void Initialize();
+
+    /**
+     * @brief Returns a texture with storage for the key, either one which was released or a newly allocated one.
+     */
+    unsigned int Acquire(const TextureKey& key);
+
+    /**
+     * @brief Returns the texture to the pool to be handed out again. The textures which don't fit in the pool are
+     * only deleted when the next texture is acquired.
+     */
+    void Release(unsigned int texture);
+
+    /**
+     * @brief Uploads the pixels onto the texture through one of the staging buffers.
+     *
+     * @param texture Texture which has been acquired for the key.
+     * @param key Size and format of the pixels.
+     * @param pixels Pixels to be uploaded.
+     * @param size Size of the pixels in bytes.
+     */
+    void Upload(unsigned int texture, const TextureKey& key, const void* pixels, std::size_t size);
+
+    /**
+     * @brief Uploads the image onto the texture, the texture is first swapped for one from the pool if it was
+     * acquired for an image of a different size or format (or if there's no texture yet).
+     *
+     * @param image Image to be uploaded.
+     * @param texture Texture to upload onto, updated if it gets swapped.
+     * @param key What the texture was acquired for, updated if it gets swapped.
+     * @param factor The image is downscaled by this factor before being uploaded, when it's displayed smaller than it is.
+     */
+    void Load(const SharedPixels& image, unsigned int& texture, TextureKey& key, int factor = 1);
+
+    /**
+     * @brief Deletes the textures which have been released.
+     */
+    void Clear();
+
+private: /* Members */
+    /* Key for every texture which has been handed out or is free */
+    std::unordered_map<unsigned int, TextureKey> m_Keys;
+    /* Textures which have been released, the oldest first */
+    std::deque<unsigned int> m_Free;
+
+    /* Staging buffers, used in turns, so an upload doesn't wait for the previous one to be read */
+    std::vector<unsigned int> m_Buffers;
+    std::vector<std::size_t> m_Capacities;
+    std::size_t m_BufferIndex;
+
+    /* Pixels of the downscaled image being uploaded */
+    std::vector<std::byte> m_Scaled;
+
+private: /* Methods */
+    /**
+     * Deletes the oldest of the released textures till only the ones which fit in the pool remain
+     */
+    void Trim();
+};
+
+VOID_NAMESPACE_CLOSE
+
+#endif // _VOID_TEXTURE_POOL_H
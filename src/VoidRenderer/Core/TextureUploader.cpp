@@ -0,0 +1,653 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+/* STD */
+#include <algorithm>
+#include <cstring>
+
+/* Qt */
+#include <QCoreApplication>
+
+/* Internal */
+#include "TextureUploader.h"
+#include "VoidCore/Logging.h"
+#include "VoidCore/Processors/ImageProcessor.h"
+
+VOID_NAMESPACE_OPEN
+
+/* How long can the upload thread wait on the GPU to be done with a buffer before giving up on it (nanoseconds) */
+static const GLuint64 UPLOAD_TIMEOUT = 1000000000;
+
+/* Number of staging buffers, allowing the next upload to be copied while the previous ones are read by the GPU */
+static const std::size_t STAGE_COUNT = 3;
+
+/* Size (bytes) of the image once downscaled by the factor */
+static std::size_t ScaledSize(const SharedPixels& image, int factor)
+{
+    const std::size_t width = static_cast<std::size_t>(image->Width());
+    const std::size_t height = static_cast<std::size_t>(image->Height());
+    const std::size_t pixel = image->FrameSize() / std::max<std::size_t>(width * height, 1);
+
+    return pixel * ((width + factor - 1) / factor) * ((height + factor - 1) / factor);
+}
+
+TextureUploader::TextureUploader(std::size_t budget, std::size_t window)
+    : m_Stages(STAGE_COUNT)
+    , m_StageIndex(0)
+    , m_Displayed(-1)
+    , m_Tick(0)
+    , m_Budget(budget)
+    , m_Used(0)
+    , m_Window(window)
+    , m_Factor(1)
+    , m_Stop(false)
+    , m_Purge(false)
+    , m_Persistent(false)
+    , m_Thread(nullptr)
+    , m_Context(nullptr)
+    , m_Surface(nullptr)
+{
+}
+
+TextureUploader::~TextureUploader()
+{
+    Release();
+}
+
+bool TextureUploader::Initialize(QOpenGLContext* share)
+{
+    /* The textures of the previous thread belong to the share group of the context which is now gone */
+    Release();
+
+    if (!share)
+        return false;
+
+    /* The surface needs to be created on the GUI thread */
+    m_Surface = new QOffscreenSurface;
+    m_Surface->setFormat(share->format());
+    m_Surface->create();
+
+    m_Context = new QOpenGLContext;
+    m_Context->setFormat(share->format());
+    m_Context->setShareContext(share);
+
+    if (!m_Context->create())
+    {
+        VOID_LOG_WARN("Unable to create the texture upload context, images will be uploaded when displayed.");
+
+        delete m_Context;
+        m_Context = nullptr;
+        delete m_Surface;
+        m_Surface = nullptr;
+        return false;
+    }
+
+    m_Stop = false;
+    m_Thread = QThread::create([this]() -> void { Run(); });
+    m_Context->moveToThread(m_Thread);
+    m_Thread->start();
+
+    return true;
+}
+
+void TextureUploader::Release()
+{
+    if (!m_Thread)
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        m_Stop = true;
+        m_Queue.clear();
+        m_Protected.clear();
+        m_Requested = nullptr;
+    }
+
+    m_Condition.notify_all();
+    m_Thread->wait();
+
+    delete m_Thread;
+    m_Thread = nullptr;
+
+    delete m_Context;
+    m_Context = nullptr;
+    delete m_Surface;
+    m_Surface = nullptr;
+
+    m_Displayed = -1;
+}
+
+void TextureUploader::SetBudget(std::size_t bytes)
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+    m_Budget = bytes;
+}
+
+void TextureUploader::SetFactor(int factor)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        if (factor == m_Factor)
+            return;
+
+        m_Factor = factor;
+
+        /* Everything resident is of the wrong size now, gets uploaded again as it's preloaded (or requested) */
+        m_Queue.clear();
+        m_Protected.clear();
+        m_Requested = nullptr;
+        m_Purge = true;
+    }
+
+    m_Condition.notify_one();
+}
+
+void TextureUploader::Preload(const std::vector<SharedPixels>& ahead, const std::vector<SharedPixels>& behind)
+{
+    if (!m_Thread)
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        m_Queue.clear();
+        m_Protected.clear();
+
+        std::size_t bytes = 0;
+        bool full = false;
+
+        /* The image the renderer is waiting on still goes first */
+        if (m_Requested)
+        {
+            bytes += ScaledSize(m_Requested, m_Factor);
+            m_Protected.push_back(m_Requested);
+
+            if (Find(m_Requested) < 0)
+                m_Queue.push_back(m_Requested);
+        }
+
+        /* The frames to be displayed next get uploaded first, nothing behind is kept once those exhaust the budget */
+        for (const std::vector<SharedPixels>* images : {&ahead, &behind})
+        {
+            for (std::size_t i = 0; i < images->size() && i < m_Window && !full; ++i)
+            {
+                const SharedPixels& image = images->at(i);
+                if (!image || image->Empty())
+                    continue;
+
+                bytes += ScaledSize(image, m_Factor);
+                full = bytes > m_Budget;
+
+                if (full)
+                    break;
+
+                m_Protected.push_back(image);
+
+                if (Find(image) < 0)
+                    m_Queue.push_back(image);
+            }
+        }
+    }
+
+    m_Condition.notify_one();
+}
+
+void TextureUploader::Request(const SharedPixels& image)
+{
+    if (!m_Thread || !image || image->Empty())
+        return;
+
+    bool ready = false;
+
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        const int index = Find(image);
+        ready = index >= 0 && m_Slots[index].ready;
+
+        /* Being uploaded already, the renderer gets to know once that's done */
+        if (!ready)
+        {
+            m_Requested = image;
+
+            if (std::find(m_Protected.begin(), m_Protected.end(), image) == m_Protected.end())
+                m_Protected.push_back(image);
+
+            if (index < 0 && std::find(m_Queue.begin(), m_Queue.end(), image) == m_Queue.end())
+                m_Queue.push_front(image);
+        }
+    }
+
+    if (ready)
+    {
+        if (m_Ready)
+            m_Ready(image);
+    }
+    else
+        m_Condition.notify_one();
+}
+
+void TextureUploader::Clear()
+{
+    if (!m_Thread)
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        m_Queue.clear();
+        m_Protected.clear();
+        m_Requested = nullptr;
+        m_Purge = true;
+    }
+
+    m_Condition.notify_one();
+}
+
+unsigned int TextureUploader::Texture(const SharedPixels& image)
+{
+    if (!m_Thread)
+        return 0;
+
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    int index = Find(image);
+    if (index >= 0 && !m_Slots[index].ready)
+        index = -1;
+
+    if (index != m_Displayed)
+    {
+        /* The previous texture can only be uploaded to once the draws using it are done */
+        if (m_Displayed >= 0)
+        {
+            Slot& previous = m_Slots[m_Displayed];
+
+            if (previous.released)
+                glDeleteSync(previous.released);
+
+            previous.released = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+        }
+
+        m_Displayed = index;
+    }
+
+    if (index < 0)
+        return 0;
+
+    Slot& slot = m_Slots[index];
+    slot.used = ++m_Tick;
+
+    /* Commands from here on wait (on the GPU) for the upload to have completed */
+    glWaitSync(slot.fence, 0, GL_TIMEOUT_IGNORED);
+    return slot.texture;
+}
+
+int TextureUploader::Find(const SharedPixels& image) const
+{
+    for (std::size_t i = 0; i < m_Slots.size(); ++i)
+    {
+        /* The displayed texture may still hold the image at the previous factor */
+        if (m_Slots[i].image == image && m_Slots[i].factor == m_Factor)
+            return static_cast<int>(i);
+    }
+
+    return -1;
+}
+
+bool TextureUploader::Evictable(std::size_t index) const
+{
+    if (static_cast<int>(index) == m_Displayed)
+        return false;
+
+    /* Of no use at the current factor, even if the image is around the displayed one */
+    if (m_Slots[index].factor != m_Factor)
+        return true;
+
+    for (const SharedPixels& image : m_Protected)
+    {
+        if (m_Slots[index].image == image)
+            return false;
+    }
+
+    return true;
+}
+
+int TextureUploader::Reserve(const SharedPixels& image, std::vector<Slot>& evicted)
+{
+    const std::size_t size = ScaledSize(image, m_Factor);
+    const int width = (image->Width() + m_Factor - 1) / m_Factor;
+    const int height = (image->Height() + m_Factor - 1) / m_Factor;
+
+    for (;;)
+    {
+        /* A slot without any texture and the least recently used texture which can be evicted */
+        int free = -1;
+        int lru = -1;
+
+        for (std::size_t i = 0; i < m_Slots.size(); ++i)
+        {
+            if (!m_Slots[i].texture)
+            {
+                if (free < 0)
+                    free = static_cast<int>(i);
+            }
+            else if (Evictable(i) && (lru < 0 || m_Slots[i].used < m_Slots[lru].used))
+                lru = static_cast<int>(i);
+        }
+
+        /* Fits in the budget as a new texture */
+        if (m_Used + size <= m_Budget)
+        {
+            if (free < 0)
+            {
+                m_Slots.emplace_back();
+                free = static_cast<int>(m_Slots.size() - 1);
+            }
+
+            Slot& slot = m_Slots[free];
+            slot.image = image;
+            slot.ready = false;
+            slot.bytes = size;
+            slot.factor = m_Factor;
+
+            m_Used += size;
+            return free;
+        }
+
+        /* Nothing left which can make room for the image */
+        if (lru < 0)
+            return -1;
+
+        Slot& slot = m_Slots[lru];
+
+        /* A texture of the same size is just uploaded onto again once the renderer is done with it */
+        if (slot.width == width && slot.height == height && slot.internalFormat == image->GLInternalFormat())
+        {
+            Slot previous;
+            previous.fence = slot.fence;
+            previous.released = slot.released;
+            evicted.push_back(previous);
+
+            slot.fence = nullptr;
+            slot.released = nullptr;
+            slot.image = image;
+            slot.ready = false;
+            slot.factor = m_Factor;
+            return lru;
+        }
+
+        /* Else the texture goes entirely */
+        evicted.push_back(slot);
+        m_Used -= slot.bytes;
+        slot = Slot();
+    }
+}
+
+void TextureUploader::Purge(std::vector<Slot>& evicted)
+{
+    for (std::size_t i = 0; i < m_Slots.size(); ++i)
+    {
+        if (static_cast<int>(i) == m_Displayed)
+            continue;
+
+        evicted.push_back(m_Slots[i]);
+        m_Used -= m_Slots[i].bytes;
+        m_Slots[i] = Slot();
+    }
+}
+
+void TextureUploader::Run()
+{
+    m_Context->makeCurrent(m_Surface);
+
+    /* Persistent mapping needs buffer storage (GL 4.4), else the buffers are mapped for each upload */
+    m_Persistent = GLEW_ARB_buffer_storage;
+
+    /* Rows of the downscaled images aren't necessarily aligned to 4 bytes */
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    /* Images larger than this are left to the renderer to be drawn in tiles */
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+
+    for (;;)
+    {
+        SharedPixels image;
+        int index = -1;
+        std::vector<Slot> evicted;
+
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Condition.wait(lock, [this]() -> bool { return m_Stop || m_Purge || !m_Queue.empty(); });
+
+            if (m_Stop)
+                break;
+
+            if (m_Purge)
+            {
+                Purge(evicted);
+                m_Purge = false;
+            }
+
+            if (!m_Queue.empty())
+            {
+                image = m_Queue.front();
+                m_Queue.pop_front();
+
+                const bool fits = (image->Width() + m_Factor - 1) / m_Factor <= maxSize
+                    && (image->Height() + m_Factor - 1) / m_Factor <= maxSize;
+
+                /* Might have been uploaded since it was queued */
+                if (fits && Find(image) < 0)
+                    index = Reserve(image, evicted);
+            }
+        }
+
+        Destroy(evicted);
+
+        if (index < 0)
+            continue;
+
+        Slot& slot = m_Slots[index];
+        GLsync fence = Upload(slot, image);
+        bool requested = false;
+
+        {
+            std::lock_guard<std::mutex> guard(m_Mutex);
+            slot.fence = fence;
+            slot.ready = (fence != nullptr);
+            slot.used = ++m_Tick;
+
+            /* Failed uploads leave the slot to be reused */
+            if (!slot.ready)
+            {
+                slot.image = nullptr;
+                slot.used = 0;
+
+                if (!slot.texture)
+                {
+                    m_Used -= slot.bytes;
+                    slot.bytes = 0;
+                }
+            }
+            else if (image == m_Requested && slot.factor == m_Factor)
+            {
+                m_Requested = nullptr;
+                requested = true;
+            }
+        }
+
+        /* The renderer swaps onto the texture on its own thread */
+        if (requested && m_Ready)
+            m_Ready(image);
+    }
+
+    std::vector<Slot> evicted;
+
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        evicted.swap(m_Slots);
+        m_Used = 0;
+    }
+
+    Destroy(evicted);
+
+    for (Stage& stage : m_Stages)
+        Destroy(stage);
+
+    m_Context->doneCurrent();
+
+    /* Back to the GUI thread to be deleted from there */
+    m_Context->moveToThread(QCoreApplication::instance()->thread());
+}
+
+GLsync TextureUploader::Upload(Slot& slot, const SharedPixels& image)
+{
+    const void* pixels = image->Pixels();
+    std::size_t size = image->FrameSize();
+    int width = image->Width();
+    int height = image->Height();
+
+    /* Images displayed smaller than they are get reduced here, off the GUI thread */
+    if (slot.factor > 1)
+    {
+        if (!ImageProcessor::Instance().Downscale(image, slot.factor, m_Scaled, width, height))
+            return nullptr;
+
+        pixels = m_Scaled.data();
+        size = m_Scaled.size();
+    }
+
+    Stage& stage = m_Stages[m_StageIndex];
+    m_StageIndex = (m_StageIndex + 1) % m_Stages.size();
+
+    /* The buffer can only be written to once the GPU is done with the previous upload from it */
+    if (stage.fence)
+    {
+        GLenum status = glClientWaitSync(stage.fence, GL_SYNC_FLUSH_COMMANDS_BIT, UPLOAD_TIMEOUT);
+
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+        {
+            glDeleteSync(stage.fence);
+            stage.fence = nullptr;
+        }
+        /**
+         * The GPU may still be reading from the buffer, writing onto its mapping now would corrupt that upload
+         * the buffer is let go instead (GL only frees it once it's no longer in use) and a new one is allocated below
+         */
+        else
+            Destroy(stage);
+    }
+
+    /* (Re)allocate the buffer if it can't hold the pixels */
+    if (stage.capacity < size)
+    {
+        Destroy(stage);
+
+        glGenBuffers(1, &stage.pbo);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stage.pbo);
+
+        if (m_Persistent)
+        {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, nullptr, flags);
+            stage.mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags);
+        }
+        else
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+
+        stage.capacity = size;
+    }
+    else
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stage.pbo);
+
+    /* Copy the pixels onto the buffer */
+    if (stage.mapped)
+        std::memcpy(stage.mapped, pixels, size);
+    else if (void* iptr = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT))
+    {
+        std::memcpy(iptr, pixels, size);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+    else
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return nullptr;
+    }
+
+    if (!slot.texture)
+    {
+        glGenTextures(1, &slot.texture);
+        glBindTexture(GL_TEXTURE_2D, slot.texture);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+    else
+        glBindTexture(GL_TEXTURE_2D, slot.texture);
+
+    /* Reallocate the texture when the image differs */
+    if (slot.width != width || slot.height != height || slot.internalFormat != image->GLInternalFormat())
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, image->GLInternalFormat(), width, height, 0, image->GLFormat(), image->GLType(), nullptr);
+
+        slot.width = width;
+        slot.height = height;
+        slot.internalFormat = image->GLInternalFormat();
+    }
+
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, image->GLFormat(), image->GLType(), 0);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    stage.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    /* The fence has to reach the GPU before the renderer's context can wait on it */
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+
+    return fence;
+}
+
+void TextureUploader::Destroy(std::vector<Slot>& evicted)
+{
+    for (Slot& slot : evicted)
+    {
+        /* The renderer might still be drawing with the texture */
+        if (slot.released)
+        {
+            glWaitSync(slot.released, 0, GL_TIMEOUT_IGNORED);
+            glDeleteSync(slot.released);
+        }
+
+        if (slot.fence)
+            glDeleteSync(slot.fence);
+
+        if (slot.texture)
+            glDeleteTextures(1, &slot.texture);
+    }
+
+    evicted.clear();
+}
+
+void TextureUploader::Destroy(Stage& stage)
+{
+    if (stage.fence)
+        glDeleteSync(stage.fence);
+
+    if (stage.pbo)
+    {
+        if (stage.mapped)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stage.pbo);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+
+        glDeleteBuffers(1, &stage.pbo);
+    }
+
+    stage = Stage();
+}
+
+VOID_NAMESPACE_CLOSE
@@ -0,0 +1,239 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#ifndef _VOID_TEXTURE_UPLOADER_H
+#define _VOID_TEXTURE_UPLOADER_H
+
+/* GLEW */
+#include <GL/glew.h>
+
+/* STD */
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/* Qt */
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QThread>
+
+/* Internal */
+#include "Definition.h"
+#include "PixReader.h"
+
+VOID_NAMESPACE_OPEN
+
+/**
+ * @brief Uploads images onto textures ahead of them being displayed and keeps them resident on the GPU.
+ *
+ * Uploads happen on a thread of its own with a context which shares objects with the renderer's context.
+ * Pixels are staged through a small ring of pixel buffers (persistently mapped when buffer storage is available)
+ * onto a texture per image, and a fence is placed after each upload, so the renderer only has to bind the texture
+ * and have the GPU wait on the fence when the image is to be displayed, instead of copying the pixels on the GUI thread.
+ *
+ * Textures stay resident till the memory they take goes over the budget, at which point the least recently
+ * used ones (outside of the frames around the one being displayed) make room for the new ones, which means
+ * a loop which fits in the budget plays entirely from the GPU after going through it once.
+ */
+class TextureUploader
+{
+    /* Texture an image has been uploaded onto */
+    struct Slot
+    {
+        /* Image which is (being) uploaded onto the texture */
+        SharedPixels image;
+        bool ready = false;
+
+        unsigned int texture = 0;
+        int width = 0;
+        int height = 0;
+        unsigned int internalFormat = 0;
+        std::size_t bytes = 0;
+        /* Factor the image was downscaled by before being uploaded */
+        int factor = 1;
+
+        /* Signalled when the upload completes */
+        GLsync fence = nullptr;
+        /* Signalled when the renderer is done drawing with the texture */
+        GLsync released = nullptr;
+
+        /* When was the texture last uploaded to or displayed, the least recent one gets evicted */
+        std::uint64_t used = 0;
+    };
+
+    /* Pixel buffer the pixels are staged in before being copied onto a texture */
+    struct Stage
+    {
+        unsigned int pbo = 0;
+        void* mapped = nullptr;
+        std::size_t capacity = 0;
+
+        /* Signalled once the GPU is done reading from the buffer */
+        GLsync fence = nullptr;
+    };
+
+public:
+    /**
+     * @param budget Memory (bytes) the resident textures can take.
+     * @param window Number of frames on either side of the displayed one which are kept resident.
+     */
+    explicit TextureUploader(std::size_t budget = 1024ull * 1024 * 1024, std::size_t window = 8);
+    ~TextureUploader();
+
+    /**
+     * @brief Creates the upload context sharing objects with the provided context and starts the upload thread.
+     * Needs to be called from the GUI thread, any previously started thread is stopped first as the
+     * textures can't be shared with a new context of the renderer.
+     *
+     * @param share Context of the renderer.
+     * @return true if the upload thread has been started.
+     */
+    bool Initialize(QOpenGLContext* share);
+
+    /**
+     * @brief Stops the upload thread and deletes the textures and buffers.
+     */
+    void Release();
+
+    /**
+     * @brief Sets the memory (bytes) the resident textures can take, textures over the budget are evicted
+     * as new ones get uploaded.
+     */
+    void SetBudget(std::size_t bytes);
+    inline std::size_t Budget() const { return m_Budget; }
+
+    /**
+     * @brief Sets the factor the images are downscaled by (on the upload thread) before being uploaded,
+     * based on how much smaller than their size they're displayed.
+     * Textures uploaded with a different factor are evicted and aren't returned any more.
+     */
+    void SetFactor(int factor);
+    inline int Factor() const { return m_Factor; }
+
+    /**
+     * Number of frames on either side of the displayed one which should be preloaded
+     */
+    inline std::size_t Window() const { return m_Window; }
+
+    /**
+     * @brief Queues images around the one being displayed to be uploaded, these aren't evicted for any others.
+     * Anything queued earlier and not yet uploaded is dropped, images which are already resident aren't uploaded again.
+     * Only as many images as fit in the budget are considered.
+     *
+     * @param ahead Images which are going to be displayed, in the order of display.
+     * @param behind Images which have been displayed, most recent first.
+     */
+    void Preload(const std::vector<SharedPixels>& ahead, const std::vector<SharedPixels>& behind = {});
+
+    /**
+     * @brief Queues the image being displayed to be uploaded at the current factor ahead of anything else,
+     * the renderer keeps drawing what it has till the image is ready, at which point the ready callback is invoked.
+     * The callback is invoked right away if the image is already resident at the factor.
+     */
+    void Request(const SharedPixels& image);
+
+    /**
+     * @brief Sets what gets called once a requested image is ready to be displayed.
+     * The callback is invoked from the upload thread (or the calling thread), needs to be set before Initialize.
+     */
+    inline void SetReadyCallback(const std::function<void(const SharedPixels&)>& callback) { m_Ready = callback; }
+
+    /**
+     * @brief Evicts all the textures apart from the one being displayed.
+     */
+    void Clear();
+
+    /**
+     * @brief Returns the texture holding the image if it's resident, 0 otherwise.
+     * Needs to be called with the renderer's context current, commands issued after this wait on the GPU
+     * for the upload to complete. The texture isn't evicted till the next image is requested.
+     */
+    unsigned int Texture(const SharedPixels& image);
+
+    inline bool Active() const { return m_Thread != nullptr; }
+
+private: /* Members */
+    std::vector<Slot> m_Slots;
+    std::vector<Stage> m_Stages;
+    std::size_t m_StageIndex;
+
+    std::deque<SharedPixels> m_Queue;
+    /* Images around the one being displayed */
+    std::vector<SharedPixels> m_Protected;
+    /* Image the renderer is waiting on to be uploaded at the current factor */
+    SharedPixels m_Requested;
+    std::function<void(const SharedPixels&)> m_Ready;
+
+    /* Slot being displayed by the renderer, -1 when nothing from the uploads is being displayed */
+    int m_Displayed;
+    std::uint64_t m_Tick;
+
+    std::size_t m_Budget;
+    std::size_t m_Used;
+    std::size_t m_Window;
+    int m_Factor;
+
+    /* Pixels of the downscaled image being uploaded */
+    std::vector<std::byte> m_Scaled;
+
+    bool m_Stop;
+    bool m_Purge;
+    bool m_Persistent;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+
+    QThread* m_Thread;
+    QOpenGLContext* m_Context;
+    QOffscreenSurface* m_Surface;
+
+private: /* Methods */
+    /**
+     * Upload loop which runs on the upload thread
+     */
+    void Run();
+
+    /**
+     * Returns the index of the slot holding the image at the current factor, -1 if the image isn't resident (or being uploaded)
+     */
+    int Find(const SharedPixels& image) const;
+
+    /**
+     * Whether the slot can be evicted, i.e. it isn't being displayed or around the displayed image at the current factor
+     */
+    bool Evictable(std::size_t index) const;
+
+    /**
+     * @brief Returns the index of the slot the image can be uploaded onto, evicting the least recently used
+     * textures till the image fits in the budget. Called with the mutex locked.
+     *
+     * @param image Image to be uploaded.
+     * @param evicted Filled in with the GL objects which need to be deleted (or waited on) before uploading.
+     * @return int Index of the slot, -1 if the image doesn't fit.
+     */
+    int Reserve(const SharedPixels& image, std::vector<Slot>& evicted);
+
+    /**
+     * Moves out all the slots apart from the displayed one, called with the mutex locked
+     */
+    void Purge(std::vector<Slot>& evicted);
+
+    /**
+     * Copies the pixels of the image onto the next staging buffer and uploads them onto the texture of the slot,
+     * returns the fence signalled once the upload completes
+     */
+    GLsync Upload(Slot& slot, const SharedPixels& image);
+
+    /**
+     * Waits for the GPU to be done with the evicted objects and deletes them, called from the upload thread
+     */
+    void Destroy(std::vector<Slot>& evicted);
+    void Destroy(Stage& stage);
+};
+
+VOID_NAMESPACE_CLOSE
+
+#endif // _VOID_TEXTURE_UPLOADER_H
@@ -2,6 +2,7 @@
 // Licensed under the MIT License
 
 /* STD */
+#include <algorithm>
 #include <cmath>
 
 /* GLEW */
@@ -15,10 +16,17 @@
 #include "GridRenderLayer.h"
 #include "VoidCore/Logging.h"
 #include "VoidCore/Profiler.h"
+#include "VoidCore/Processors/ImageProcessor.h"
 #include "VoidRenderer/Core/Error.h"
 
 VOID_NAMESPACE_OPEN
 
+/* Largest side of an image uploaded for a cell, larger images are downscaled to fit */
+static const int MAX_CELL_SIZE = 1024;
+
+/* Number of floats for the attributes of a cell: rect (4), layer (3), transform rows (3 + 3), colorspace (1) */
+static const int INSTANCE_SIZE = 14;
+
 GridRenderLayer::GridRenderLayer()
     : m_Exposure(0.f)
     , m_Gamma(1.f)
@@ -33,44 +41,61 @@ GridRenderLayer::GridRenderLayer()
     , m_VAO(0)
     , m_VBO(0)
     , m_EBO(0)
+    , m_InstanceBuffer(0)
+    , m_Texture(0)
+    , m_TextureWidth(0)
+    , m_TextureHeight(0)
+    , m_TextureLayers(0)
+    , m_MaxTextureLayers(0)
 {
 }
 
 GridRenderLayer::~GridRenderLayer()
 {
-    glDeleteTextures(m_Textures.size(), m_Textures.data());
 }
 
 void GridRenderLayer::Initialize()
 {
+    /* The texture (if any) belonged to the previous context */
+    m_Texture = 0;
+    m_TextureWidth = 0;
+    m_TextureHeight = 0;
+    m_TextureLayers = 0;
+    m_Images.clear();
+    m_TexData.clear();
+
     m_Shader.Initialize();
 
-    SetupBuffers();
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &m_MaxTextureLayers);
 
-    m_UProjection = glGetUniformLocation(m_Shader.ProgramId(), "uMVP");
-    m_UTexture = glGetUniformLocation(m_Shader.ProgramId(), "uTexture");
-    m_UExposure = glGetUniformLocation(m_Shader.ProgramId(), "exposure");
-    m_UGamma = glGetUniformLocation(m_Shader.ProgramId(), "gamma");
-    m_UGain = glGetUniformLocation(m_Shader.ProgramId(), "gain");
-    m_UChannelMode = glGetUniformLocation(m_Shader.ProgramId(), "channelMode");
-    m_UInputColorSpace = glGetUniformLocation(m_Shader.ProgramId(), "inputColorSpace");
+    SetupBuffers();
+    LoadUniforms();
 }
 
 void GridRenderLayer::Reset()
 {
-    glDeleteTextures(m_Textures.size(), m_Textures.data());
+    if (m_Texture)
+        glDeleteTextures(1, &m_Texture);
 
-    m_Textures.clear();
-    m_Textures.shrink_to_fit();
+    m_Texture = 0;
+    m_TextureWidth = 0;
+    m_TextureHeight = 0;
+    m_TextureLayers = 0;
+
+    m_Images.clear();
+    m_Images.shrink_to_fit();
 
     m_TexData.clear();
     m_TexData.shrink_to_fit();
+
+    m_Scaled.clear();
+    m_Scaled.shrink_to_fit();
 }
 
 void GridRenderLayer::SetRows(int rows)
 {
     m_Rows = rows;
-    m_Columns = std::ceil(static_cast<float>(m_Textures.size()) / rows);
+    m_Columns = std::ceil(static_cast<float>(m_Images.size()) / rows);
 
     m_CellWidth = 2.f / m_Columns;
     m_CellHeight = 2.f / m_Rows;
@@ -79,91 +104,79 @@ void GridRenderLayer::SetRows(int rows)
 void GridRenderLayer::SetColumns(int columns)
 {
     m_Columns = columns;
-    m_Rows = std::ceil(static_cast<float>(m_Textures.size()) / columns);
+    m_Rows = std::ceil(static_cast<float>(m_Images.size()) / columns);
 
     m_CellWidth = 2.f / m_Columns;
     m_CellHeight = 2.f / m_Rows;
 }
 
-void GridRenderLayer::SetImages(const std::vector<SharedPixels>& images)
+void GridRenderLayer::SetImages(const std::vector<SharedPixels>& images, const std::vector<TextureTransform>& transforms)
 {
-    if (m_Textures.size() != images.size())
+    if (m_Images.size() != images.size())
     {
         Reset();
 
-        m_Textures.resize(images.size());
+        m_Images.resize(images.size());
         m_TexData.resize(images.size());
 
-        glGenTextures(images.size(), m_Textures.data());
-
         // Auto layout grid
-        SetRows(std::ceil(std::sqrt(m_Textures.size())));
+        SetRows(std::ceil(std::sqrt(m_Images.size())));
     }
 
-    for (int i = 0; i < images.size(); ++i)
+    /* The layers need to be as large as the largest of the downscaled images */
+    int width = 1, height = 1;
+
+    for (const SharedPixels& image : images)
     {
-        glBindTexture(GL_TEXTURE_2D, m_Textures[i]);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            images[i]->GLInternalFormat(),
-            images[i]->Width(),
-            images[i]->Height(),
-            0,
-            images[i]->GLFormat(),
-            images[i]->GLType(),
-            images[i]->Pixels()
-        );
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-        m_TexData[i] = std::move(ImageData(
-            images[i]->Width(),
-            images[i]->Height(),
-            static_cast<int>(images[i]->InputColorSpace())
-        ));
+        if (!image)
+            continue;
+
+        const int factor = Factor(image);
+        width = std::max(width, (image->Width() + factor - 1) / factor);
+        height = std::max(height, (image->Height() + factor - 1) / factor);
+    }
+
+    /* Everything gets uploaded again onto a newly allocated array */
+    if (Allocate(width, height, static_cast<int>(images.size())))
+        std::fill(m_Images.begin(), m_Images.end(), nullptr);
+
+    for (std::size_t i = 0; i < images.size(); ++i)
+    {
+        /* A cell which has no image anymore is left empty instead of showing what it had before */
+        if (!images[i])
+            m_Images[i] = nullptr;
+        /* Only the cells which are showing a different image than before are uploaded */
+        else if (images[i] != m_Images[i] && i < static_cast<std::size_t>(m_TextureLayers))
+            Upload(static_cast<int>(i), images[i]);
+
+        m_TexData[i].transform = i < transforms.size() ? transforms[i] : TextureTransform();
     }
 }
 
 void GridRenderLayer::ReinitShaderProgram()
 {
     m_Shader.Reinitialize();
-
-    m_UProjection = glGetUniformLocation(m_Shader.ProgramId(), "uMVP");
-    m_UTexture = glGetUniformLocation(m_Shader.ProgramId(), "uTexture");
-    m_UExposure = glGetUniformLocation(m_Shader.ProgramId(), "exposure");
-    m_UGamma = glGetUniformLocation(m_Shader.ProgramId(), "gamma");
-    m_UGain = glGetUniformLocation(m_Shader.ProgramId(), "gain");
-    m_UChannelMode = glGetUniformLocation(m_Shader.ProgramId(), "channelMode");
-    m_UInputColorSpace = glGetUniformLocation(m_Shader.ProgramId(), "inputColorSpace");
+    LoadUniforms();
 }
 
 void GridRenderLayer::Render(const glm::mat4&, float width, float height)
 {
-    m_Shader.Bind();
+    if (!m_Texture || m_Images.empty())
+        return;
 
     float viewAspect = width / height;
     float cellWidth = m_CellWidth * viewAspect;
 
-    glBindVertexArray(m_VAO);
-
-    glUniform1f(m_UExposure, m_Exposure);
-    glUniform1f(m_UGamma, m_Gamma);
-    glUniform1f(m_UGain, m_Gain);
-    glUniform1i(m_UChannelMode, m_ChannelMode);
+    /* Attributes of the cells, these change with the size of the viewport and are cheap enough to be filled each draw */
+    m_Instances.resize(m_Images.size() * INSTANCE_SIZE);
 
-    for (int i = 0; i < static_cast<int>(m_Textures.size()); ++i)
+    for (int i = 0; i < static_cast<int>(m_Images.size()); ++i)
     {
         int row = i / m_Columns;
         int col = i % m_Columns;
 
-        float aspect = (float)m_TexData[i].width / m_TexData[i].height;
+        const ImageData& data = m_TexData[i];
+        float aspect = (float)data.width / data.height;
 
         float scalex, scaley;
         if (aspect > (cellWidth / m_CellHeight))
@@ -177,29 +190,45 @@ void GridRenderLayer::Render(const glm::mat4&, float width, float height)
             scalex = scaley * aspect;
         }
 
-        float offsetx = -viewAspect + (col + 0.5f) * cellWidth;
-        float offsety = 1.f - (row + 0.5f) * m_CellHeight;
+        /* Cells without an image are left empty */
+        if (!m_Images[i])
+            scalex = scaley = 0.f;
 
-        glm::mat4 model(1.f);
-        model = glm::translate(model, glm::vec3(offsetx, offsety, 0.f));
-        model = glm::scale(model, glm::vec3(scalex, scaley, 1.f));
+        const float* m = data.transform.m;
+        const float instance[INSTANCE_SIZE] = {
+            -viewAspect + (col + 0.5f) * cellWidth, 1.f - (row + 0.5f) * m_CellHeight, scalex, scaley,
+            static_cast<float>(data.textureWidth) / m_TextureWidth, static_cast<float>(data.textureHeight) / m_TextureHeight, static_cast<float>(i),
+            m[0], m[1], m[2],
+            m[3], m[4], m[5],
+            static_cast<float>(data.colorspace)
+        };
 
-        glm::mat4 view = glm::mat4(1.f);
-        glm::mat4 projection = glm::ortho(-viewAspect, viewAspect, -1.f, 1.f);
+        std::copy(instance, instance + INSTANCE_SIZE, m_Instances.begin() + i * INSTANCE_SIZE);
+    }
 
-        glm::mat4 mvp = projection * view * model;
+    glBindBuffer(GL_ARRAY_BUFFER, m_InstanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, m_Instances.size() * sizeof(float), m_Instances.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-        glUniformMatrix4fv(m_UProjection, 1, GL_FALSE, glm::value_ptr(mvp));
-        glUniform1i(m_UInputColorSpace, m_TexData[i].colorspace);
+    m_Shader.Bind();
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_Textures[i]);
-        glUniform1i(m_UTexture, 0);
+    glm::mat4 projection = glm::ortho(-viewAspect, viewAspect, -1.f, 1.f);
+    glUniformMatrix4fv(m_UProjection, 1, GL_FALSE, glm::value_ptr(projection));
 
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    }
+    glUniform1f(m_UExposure, m_Exposure);
+    glUniform1f(m_UGamma, m_Gamma);
+    glUniform1f(m_UGain, m_Gain);
+    glUniform1i(m_UChannelMode, m_ChannelMode);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_Texture);
+    glUniform1i(m_UTexture, 0);
 
+    glBindVertexArray(m_VAO);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, static_cast<GLsizei>(m_Images.size()));
     glBindVertexArray(0);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
     m_Shader.Release();
 }
 
@@ -208,6 +237,7 @@ void GridRenderLayer::SetupBuffers()
     glGenVertexArrays(1, &m_VAO);
     glGenBuffers(1, &m_VBO);
     glGenBuffers(1, &m_EBO);
+    glGenBuffers(1, &m_InstanceBuffer);
 
     float vertices[16] = {
         // Pos (0)  // Tex (1)
@@ -234,7 +264,108 @@ void GridRenderLayer::SetupBuffers()
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
+    /* Per cell attributes, advancing once for each instance */
+    glBindBuffer(GL_ARRAY_BUFFER, m_InstanceBuffer);
+
+    const GLsizei stride = INSTANCE_SIZE * sizeof(float);
+    const int sizes[5] = { 4, 3, 3, 3, 1 };
+    std::size_t offset = 0;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        glVertexAttribPointer(2 + i, sizes[i], GL_FLOAT, GL_FALSE, stride, (void*)(offset * sizeof(float)));
+        glEnableVertexAttribArray(2 + i);
+        glVertexAttribDivisor(2 + i, 1);
+
+        offset += sizes[i];
+    }
+
     glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GridRenderLayer::LoadUniforms()
+{
+    m_UProjection = glGetUniformLocation(m_Shader.ProgramId(), "uProjection");
+    m_UTexture = glGetUniformLocation(m_Shader.ProgramId(), "uTexture");
+    m_UExposure = glGetUniformLocation(m_Shader.ProgramId(), "exposure");
+    m_UGamma = glGetUniformLocation(m_Shader.ProgramId(), "gamma");
+    m_UGain = glGetUniformLocation(m_Shader.ProgramId(), "gain");
+    m_UChannelMode = glGetUniformLocation(m_Shader.ProgramId(), "channelMode");
+}
+
+int GridRenderLayer::Factor(const SharedPixels& image) const
+{
+    const int size = std::max(image->Width(), image->Height());
+    return std::max(1, (size + MAX_CELL_SIZE - 1) / MAX_CELL_SIZE);
+}
+
+bool GridRenderLayer::Allocate(int width, int height, int layers)
+{
+    /* Cells beyond what the array can hold are left empty */
+    const int count = m_MaxTextureLayers > 0 ? std::min(layers, m_MaxTextureLayers) : layers;
+
+    if (m_Texture && width <= m_TextureWidth && height <= m_TextureHeight && count == m_TextureLayers)
+        return false;
+
+    if (count < layers)
+        VOID_LOG_WARN("Grid has {0} cells, only {1} of these can be shown.", layers, count);
+
+    layers = count;
+
+    if (m_Texture)
+        glDeleteTextures(1, &m_Texture);
+
+    /* Never shrinks, so switching between images of different sizes doesn't keep reallocating */
+    m_TextureWidth = std::max(width, m_TextureWidth);
+    m_TextureHeight = std::max(height, m_TextureHeight);
+    m_TextureLayers = layers;
+
+    glGenTextures(1, &m_Texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_Texture);
+
+    /* Half floats hold any of the types of the images, the downscaled ones are small enough for it to not matter */
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA16F, m_TextureWidth, m_TextureHeight, layers, 0, GL_RGBA, GL_HALF_FLOAT, nullptr);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    return true;
+}
+
+void GridRenderLayer::Upload(int layer, const SharedPixels& image)
+{
+    const int factor = Factor(image);
+
+    int width = image->Width();
+    int height = image->Height();
+    const void* pixels = image->Pixels();
+
+    if (factor > 1)
+    {
+        if (!ImageProcessor::Instance().Downscale(image, factor, m_Scaled, width, height))
+            return;
+
+        pixels = m_Scaled.data();
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_Texture);
+
+    /* Rows of the downscaled images aren't necessarily aligned to 4 bytes */
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1, image->GLFormat(), image->GLType(), pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    m_Images[layer] = image;
+
+    m_TexData[layer] = ImageData(image->Width(), image->Height(), static_cast<int>(image->InputColorSpace()));
+    m_TexData[layer].textureWidth = width;
+    m_TexData[layer].textureHeight = height;
 }
 
 VOID_NAMESPACE_CLOSE
@@ -5,13 +5,14 @@
 #define _GRID_RENDER_LAYER_H
 
 /* STD */
+#include <cstddef>
 #include <vector>
 
 /* Internal */
 #include "Definition.h"
 #include "PixReader.h"
 #include "VoidRenderer/Core/RenderTypes.h"
-#include "VoidRenderer/Programs/ImageShaderProgram.h"
+#include "VoidRenderer/Programs/GridShaderProgram.h"
 
 VOID_NAMESPACE_OPEN
 
@@ -21,10 +22,25 @@ struct ImageData
     int height;
     int colorspace;
 
-    ImageData() : width(1), height(1), colorspace(0) {}
-    ImageData(int width, int height, int colorspace) : width(width), height(height), colorspace(colorspace) {}
+    /* Size of the (downscaled) image on its layer */
+    int textureWidth;
+    int textureHeight;
+
+    /* Geometric operators of the media, applied on the texture coordinates */
+    TextureTransform transform;
+
+    ImageData() : width(1), height(1), colorspace(0), textureWidth(1), textureHeight(1) {}
+    ImageData(int width, int height, int colorspace)
+        : width(width), height(height), colorspace(colorspace), textureWidth(width), textureHeight(height) {}
 };
 
+/**
+ * @brief Draws a grid of images, e.g. all the media of a playlist at once.
+ *
+ * The images are downscaled to what a cell could reasonably display and uploaded onto the layers of
+ * a single texture array, a layer only getting uploaded again when the image of its cell changes, and all of the cells
+ * are drawn with a single instanced draw.
+ */
 class GridRenderLayer
 {
 public:
@@ -34,7 +50,13 @@ public:
     void Initialize();
     void Reset();
 
-    void SetImages(const std::vector<SharedPixels>& images);
+    /**
+     * @brief Sets the images to be drawn on the grid.
+     *
+     * @param images Images for each of the cells.
+     * @param transforms Transforms of the geometric operators for each of the images, identity for any missing.
+     */
+    void SetImages(const std::vector<SharedPixels>& images, const std::vector<TextureTransform>& transforms = {});
 
     inline void SetExposure(const float exposure) { m_Exposure = exposure; }
     inline void SetGamma(const float gamma) { m_Gamma = gamma; }
@@ -59,7 +81,7 @@ private: /* Members */
     float m_Gain;
     int m_ChannelMode;
 
-    ImageShaderProgram m_Shader;
+    GridShaderProgram m_Shader;
 
     int m_UProjection;
     int m_UTexture;
@@ -67,17 +89,47 @@ private: /* Members */
     int m_UGamma;
     int m_UGain;
     int m_UChannelMode;
-    int m_UInputColorSpace;
 
     float m_CellWidth, m_CellHeight;
     int m_Rows, m_Columns;
     unsigned int m_VAO, m_VBO, m_EBO;
 
-    std::vector<unsigned int> m_Textures;
+    /* Attributes of each of the cells */
+    unsigned int m_InstanceBuffer;
+    std::vector<float> m_Instances;
+
+    /* Texture array with a layer for each of the cells */
+    unsigned int m_Texture;
+    int m_TextureWidth, m_TextureHeight, m_TextureLayers;
+    /* Number of layers the texture array can have (GL_MAX_ARRAY_TEXTURE_LAYERS) */
+    int m_MaxTextureLayers;
+
+    /* Images which have been uploaded onto the layers */
+    std::vector<SharedPixels> m_Images;
     std::vector<ImageData> m_TexData;
 
+    /* Pixels of the downscaled image being uploaded */
+    std::vector<std::byte> m_Scaled;
+
 private: /* Methods */
     void SetupBuffers();
+    void LoadUniforms();
+
+    /**
+     * Returns the factor the image is downscaled by before being uploaded
+     */
+    int Factor(const SharedPixels& image) const;
+
+    /**
+     * Allocates the texture array if it can't hold the layers of the given size,
+     * returns true if it was (re)allocated, which means the contents of all the layers are gone
+     */
+    bool Allocate(int width, int height, int layers);
+
+    /**
+     * Downscales the image and uploads it onto the layer
+     */
+    void Upload(int layer, const SharedPixels& image);
 };
 
 VOID_NAMESPACE_CLOSE
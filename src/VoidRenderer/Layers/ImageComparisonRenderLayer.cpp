@@ -24,8 +24,6 @@ ImageComparisonRenderLayer::ImageComparisonRenderLayer()
     , m_VAO(0)
     , m_VBO(0)
     , m_IBO(0)
-    , m_PBOIndexA(0)
-    , m_PBOIndexB(0)
     , m_UProjection(-1)
     , m_UTextureA(-1)
     , m_UTextureB(-1)
@@ -39,6 +37,7 @@ ImageComparisonRenderLayer::ImageComparisonRenderLayer()
     , m_UPeelFactor(-1)
     , m_UInputColorSpaceA(-1)
     , m_UInputColorSpaceB(-1)
+    , m_Pool(nullptr)
     , m_TextureA(0)
     , m_TextureB(0)
 {
@@ -46,19 +45,26 @@ ImageComparisonRenderLayer::ImageComparisonRenderLayer()
 
 ImageComparisonRenderLayer::~ImageComparisonRenderLayer()
 {
-    /* Destroy the bound texture */
-    glDeleteTextures(1, &m_TextureA);
-    glDeleteTextures(1, &m_TextureB);
 }
 
 void ImageComparisonRenderLayer::Reset()
 {
-    m_InternalFormatA = 0;
-    m_InternalFormatB = 0;
+    /* The textures go back to the pool to be used for whatever gets displayed next */
+    if (m_Pool)
+    {
+        m_Pool->Release(m_TextureA);
+        m_Pool->Release(m_TextureB);
+    }
+
+    m_TextureA = 0;
+    m_TextureB = 0;
+    m_KeyA = TextureKey();
+    m_KeyB = TextureKey();
 }
 
-void ImageComparisonRenderLayer::Initialize()
+void ImageComparisonRenderLayer::Initialize(TexturePool& pool)
 {
+    m_Pool = &pool;
     Reset();
 
     /* Initialize the Shaders */
@@ -81,34 +87,6 @@ void ImageComparisonRenderLayer::Initialize()
     m_UPeelFactor = glGetUniformLocation(m_Shader.ProgramId(), "peelFactor");
     m_UInputColorSpaceA = glGetUniformLocation(m_Shader.ProgramId(), "inputColorSpaceA");
     m_UInputColorSpaceB = glGetUniformLocation(m_Shader.ProgramId(), "inputColorSpaceB");
-
-    /* Gen Texture for Render */
-    glGenTextures(1, &m_TextureA);
-    glGenTextures(1, &m_TextureB);
-}
-
-void ImageComparisonRenderLayer::InitTextureA(const SharedPixels& image)
-{
-    glTexImage2D(GL_TEXTURE_2D, 0, image->GLInternalFormat(), image->Width(), image->Height(), 0, image->GLFormat(), image->GLType(), nullptr);
-    m_InternalFormatA = image->GLInternalFormat();
-
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PBOs_A[0]);
-    glBufferData(GL_PIXEL_UNPACK_BUFFER, image->FrameSize(), nullptr, GL_STREAM_DRAW);
-
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PBOs_A[1]);
-    glBufferData(GL_PIXEL_UNPACK_BUFFER, image->FrameSize(), nullptr, GL_STREAM_DRAW);
-}
-
-void ImageComparisonRenderLayer::InitTextureB(const SharedPixels& image)
-{
-    glTexImage2D(GL_TEXTURE_2D, 0, image->GLInternalFormat(), image->Width(), image->Height(), 0, image->GLFormat(), image->GLType(), nullptr);
-    m_InternalFormatB = image->GLInternalFormat();
-
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PBOs_B[0]);
-    glBufferData(GL_PIXEL_UNPACK_BUFFER, image->FrameSize(), nullptr, GL_STREAM_DRAW);
-
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PBOs_B[1]);
-    glBufferData(GL_PIXEL_UNPACK_BUFFER, image->FrameSize(), nullptr, GL_STREAM_DRAW);
 }
 
 void ImageComparisonRenderLayer::SetImageA(const SharedPixels& image)
@@ -117,28 +95,7 @@ void ImageComparisonRenderLayer::SetImageA(const SharedPixels& image)
     if (!image)
         return;
 
-    /* Bind the Generated texture for Render */
-    glBindTexture(GL_TEXTURE_2D, m_TextureA);
-    /**
-     * Load the image data onto the Texture 2D
-     */
-    if (m_InternalFormatA != image->GLInternalFormat())
-        InitTextureA(image);
-
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PBOs_A[m_PBOIndexA]);
-    m_PBOIndexA = (m_PBOIndexA + 1) % 2;
-
-    if (void* iptr = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY))
-    {
-        memcpy(iptr, image->Pixels(), image->FrameSize());
-        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
-    }
-
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image->Width(), image->Height(), image->GLFormat(), image->GLType(), 0);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    m_Pool->Load(image, m_TextureA, m_KeyA);
 
     /* Update the colorspace on the Image Data */
     m_InputColorSpaceA = static_cast<int>(image->InputColorSpace());
@@ -150,28 +107,7 @@ void ImageComparisonRenderLayer::SetImageB(const SharedPixels& image)
     if (!image)
         return;
 
-    /* Bind the Generated texture for Render */
-    glBindTexture(GL_TEXTURE_2D, m_TextureB);
-    /**
-     * Load the image data onto the Texture 2D
-     */
-    if (m_InternalFormatB != image->GLInternalFormat())
-        InitTextureB(image);
-
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PBOs_B[m_PBOIndexB]);
-    m_PBOIndexB = (m_PBOIndexB + 1) % 2;
-
-    if (void* iptr = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY))
-    {
-        memcpy(iptr, image->Pixels(), image->FrameSize());
-        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
-    }
-
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image->Width(), image->Height(), image->GLFormat(), image->GLType(), 0);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    m_Pool->Load(image, m_TextureB, m_KeyB);
 
     /* Update the colorspace on the Image Data */
     m_InputColorSpaceB = static_cast<int>(image->InputColorSpace());
@@ -254,10 +190,6 @@ void ImageComparisonRenderLayer::SetupBuffers()
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
-    /* Pixel Buffer Objects */
-    glGenBuffers(2, m_PBOs_A);
-    glGenBuffers(2, m_PBOs_B);
-
     /* Unbind */
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
@@ -8,6 +8,7 @@
 #include "Definition.h"
 #include "PixReader.h"
 #include "VoidRenderer/Core/RenderTypes.h"
+#include "VoidRenderer/Core/TexturePool.h"
 #include "VoidRenderer/Programs/ImageComparisonShaderProgram.h"
 #include "VoidRenderer/Programs/SwiperShaderProgram.h"
 
@@ -19,8 +20,8 @@ public:
     ImageComparisonRenderLayer();
     ~ImageComparisonRenderLayer();
 
-    /* Sets up the Render Components (Gears) */
-    void Initialize();
+    /* Sets up the Render Components (Gears), textures for the images come from the pool */
+    void Initialize(TexturePool& pool);
 
     void Reset();
 
@@ -82,10 +83,6 @@ private: /* Members */
     unsigned int m_VAO;
     unsigned int m_VBO;
     unsigned int m_IBO;
-    unsigned int m_PBOs_A[2];
-    unsigned int m_PBOs_B[2];
-    int m_PBOIndexA;
-    int m_PBOIndexB;
 
     /* Uniforms */
     int m_UProjection;
@@ -102,18 +99,14 @@ private: /* Members */
     int m_UInputColorSpaceA;
     int m_UInputColorSpaceB;
 
-    /* Render Texture */
+    /* Render Textures and the storage they have been acquired for */
+    TexturePool* m_Pool;
     unsigned int m_TextureA;
     unsigned int m_TextureB;
-
-    /* Internal Formats for GL */
-    unsigned int m_InternalFormatA;
-    unsigned int m_InternalFormatB;
+    TextureKey m_KeyA;
+    TextureKey m_KeyB;
 
 private: /* Members */
-    void InitTextureA(const SharedPixels& image);
-    void InitTextureB(const SharedPixels& image);
-
     /**
      * @brief Setup Array Buffers
      * Initialize the Array Buffers to be used in the program
@@ -1,27 +1,59 @@
 // Copyright (c) 2025 waaake
 // Licensed under the MIT License
 
+/* STD */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 /* GLEW */
 #include <GL/glew.h>
 
 /* GLM */
+#include <glm/common.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 /* Internal */
 #include "ImageRenderLayer.h"
+#include "VoidCore/Processors/ImageProcessor.h"
 
 VOID_NAMESPACE_OPEN
 
+/* Size of the tiles of the images which are too large for a single texture */
+static const int TILE_SIZE = 2048;
+
+/* Maps the positions of the quad (-1 - 1) to its texture coordinates (0 - 1, v pointing down) and back */
+static const TextureTransform s_PositionToCoord(0.5f, 0.f, 0.5f, 0.f, -0.5f, 0.5f);
+static const TextureTransform s_CoordToPosition(2.f, 0.f, -1.f, 0.f, -2.f, 1.f);
+
+/**
+ * Returns the inverse of the transform, identity if it can't be inverted
+ */
+static TextureTransform Inverse(const TextureTransform& transform)
+{
+    const float* m = transform.m;
+    const float det = m[0] * m[4] - m[1] * m[3];
+
+    if (std::abs(det) < 1e-8f)
+        return TextureTransform();
+
+    const float a = m[4] / det, b = -m[1] / det;
+    const float d = -m[3] / det, e = m[0] / det;
+
+    return TextureTransform(a, b, -(a * m[2] + b * m[5]), d, e, -(d * m[2] + e * m[5]));
+}
+
 ImageRenderLayer::ImageRenderLayer()
     : m_Exposure(0.f)
     , m_Gamma(1.f)
     , m_Gain(1.f)
     , m_ChannelMode(5) /* RGBA */
     , m_InputColorSpace(0)
+    , m_Channels(4)
+    , m_OperatorsChanged(false)
     , m_VAO(0)
     , m_VBO(0)
     , m_IBO(0)
-    , m_PBOIndex(0)
     , m_UProjection(-1)
     , m_UTexture(-1)
     , m_UExposure(-1)
@@ -29,25 +61,53 @@ ImageRenderLayer::ImageRenderLayer()
     , m_UGain(-1)
     , m_UChannelMode(-1)
     , m_UInputColorSpace(-1)
+    , m_UChannels(-1)
+    , m_UTexTransform(-1)
+    , m_Pool(nullptr)
     , m_Texture(0)
+    , m_ActiveTexture(0)
+    , m_MaxTextureSize(TILE_SIZE)
+    , m_TiledPixels(nullptr)
+    , m_TiledWidth(0)
+    , m_TiledHeight(0)
+    , m_PixelSize(0)
 {
 }
 
 ImageRenderLayer::~ImageRenderLayer()
 {
-    /* Destroy the bound texture */
-    glDeleteTextures(1, &m_Texture);
+    /* Deleted with the context current, the textures are deleted by the pool they were acquired from */
+    if (m_VAO)
+    {
+        glDeleteVertexArrays(1, &m_VAO);
+        glDeleteBuffers(1, &m_VBO);
+        glDeleteBuffers(1, &m_IBO);
+    }
 }
 
 void ImageRenderLayer::Reset()
 {
-    m_InternalFormat = 0;
+    /* The texture goes back to the pool to be used for whatever gets displayed next */
+    if (m_Pool)
+        m_Pool->Release(m_Texture);
+
+    m_Texture = 0;
+    m_ActiveTexture = 0;
+    m_Key = TextureKey();
+
+    ReleaseTiles();
 }
 
-void ImageRenderLayer::Initialize()
+void ImageRenderLayer::Initialize(TexturePool& pool)
 {
+    m_Pool = &pool;
+
+    /* Textures of the tiles belonged to the previous context */
+    m_Tiles.clear();
     Reset();
 
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &m_MaxTextureSize);
+
     /* Initialize the Shaders */
     m_Shader.Initialize();
 
@@ -55,70 +115,183 @@ void ImageRenderLayer::Initialize()
     SetupBuffers();
 
     /* Load all the locations for uniforms */
-    m_UProjection = glGetUniformLocation(m_Shader.ProgramId(), "uMVP");
-    m_UTexture = glGetUniformLocation(m_Shader.ProgramId(), "uTexture");
-    m_UExposure = glGetUniformLocation(m_Shader.ProgramId(), "exposure");
-    m_UGamma = glGetUniformLocation(m_Shader.ProgramId(), "gamma");
-    m_UGain = glGetUniformLocation(m_Shader.ProgramId(), "gain");
-    m_UChannelMode = glGetUniformLocation(m_Shader.ProgramId(), "channelMode");
-    m_UInputColorSpace = glGetUniformLocation(m_Shader.ProgramId(), "inputColorSpace");
+    LoadUniforms();
+}
 
-    /* Gen Texture for Render */
-    glGenTextures(1, &m_Texture);
+void ImageRenderLayer::SetImage(const SharedPixels& image, int factor)
+{
+    /* Nothing to load */
+    if (!image)
+        return;
+
+    const TextureKey key(image, factor);
+
+    /* Too large for a single texture */
+    if (key.width > m_MaxTextureSize || key.height > m_MaxTextureSize)
+    {
+        m_Pool->Release(m_Texture);
+        m_Texture = 0;
+        m_Key = TextureKey();
+
+        SetTiles(image, factor);
+    }
+    else
+    {
+        ReleaseTiles();
+
+        /* A texture of a different size or format is swapped for one from the pool */
+        m_Pool->Load(image, m_Texture, m_Key, factor);
+    }
+
+    m_ActiveTexture = m_Texture;
+    m_InputColorSpace = static_cast<int>(image->InputColorSpace());
+    m_Channels = image->Channels();
 }
 
-void ImageRenderLayer::ReinitBuffer(const SharedPixels& image)
+void ImageRenderLayer::SetTexture(const SharedPixels& image, unsigned int texture)
 {
-    /* Init the bound tex with null image for Tex*/
-    glTexImage2D(GL_TEXTURE_2D, 0, image->GLInternalFormat(), image->Width(), image->Height(), 0, image->GLFormat(), image->GLType(), nullptr);
-    m_InternalFormat = image->GLInternalFormat();
+    ReleaseTiles();
 
-    /* Re-alloc the pixel buffer as the texture size has changed */
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PBOs[0]);
-    glBufferData(GL_PIXEL_UNPACK_BUFFER, image->FrameSize(), nullptr, GL_STREAM_DRAW);
+    m_ActiveTexture = texture;
+    m_InputColorSpace = static_cast<int>(image->InputColorSpace());
+    m_Channels = image->Channels();
+}
 
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PBOs[1]);
-    glBufferData(GL_PIXEL_UNPACK_BUFFER, image->FrameSize(), nullptr, GL_STREAM_DRAW);
+void ImageRenderLayer::SetTiles(const SharedPixels& image, int factor)
+{
+    int width = image->Width();
+    int height = image->Height();
+    const std::byte* pixels = static_cast<const std::byte*>(image->Pixels());
+
+    if (factor > 1)
+    {
+        if (!ImageProcessor::Instance().Downscale(image, factor, m_Scaled, width, height))
+            return;
+
+        pixels = m_Scaled.data();
+    }
+
+    /* Textures are kept for the next image of the same size, e.g. the next frame of a sequence */
+    if (width != m_TiledWidth || height != m_TiledHeight || m_Tiles.empty())
+    {
+        ReleaseTiles();
+
+        const int size = std::min(TILE_SIZE, m_MaxTextureSize);
+
+        for (int y = 0; y < height; y += size)
+        {
+            for (int x = 0; x < width; x += size)
+            {
+                Tile tile;
+                tile.x = x;
+                tile.y = y;
+                tile.width = std::min(size, width - x);
+                tile.height = std::min(size, height - y);
+
+                m_Tiles.push_back(tile);
+            }
+        }
+    }
+
+    for (Tile& tile : m_Tiles)
+        tile.loaded = false;
+
+    m_TiledImage = image;
+    m_TiledPixels = pixels;
+    m_TiledWidth = width;
+    m_TiledHeight = height;
+    m_PixelSize = image->FrameSize() / (static_cast<std::size_t>(image->Width()) * image->Height());
 }
 
-void ImageRenderLayer::SetImage(const SharedPixels& image)
+void ImageRenderLayer::ReleaseTiles()
 {
-    /* Nothing to load */
-    if (!image)
-        return;
+    if (m_Pool)
+    {
+        for (const Tile& tile : m_Tiles)
+            m_Pool->Release(tile.texture);
+    }
 
-    /* Bind the Generated texture for Render */
-    glBindTexture(GL_TEXTURE_2D, m_Texture);
+    m_Tiles.clear();
+    m_TiledImage = nullptr;
+    m_TiledPixels = nullptr;
+    m_TiledWidth = 0;
+    m_TiledHeight = 0;
+}
 
-    /**
-     * Load the image data onto the Texture 2D
-     */
-    if (m_InternalFormat != image->GLInternalFormat())
-        ReinitBuffer(image);
+void ImageRenderLayer::LoadTile(Tile& tile)
+{
+    TextureKey key;
+    key.width = tile.width;
+    key.height = tile.height;
+    key.internalFormat = m_TiledImage->GLInternalFormat();
+    key.format = m_TiledImage->GLFormat();
+    key.type = m_TiledImage->GLType();
+
+    if (!tile.texture || key != tile.key)
+    {
+        m_Pool->Release(tile.texture);
+        tile.texture = m_Pool->Acquire(key);
+        tile.key = key;
+    }
 
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PBOs[m_PBOIndex]);
-    m_PBOIndex = (m_PBOIndex + 1) % 2;
+    /* Rows of the tile are gathered from the image to be staged together */
+    const std::size_t row = tile.width * m_PixelSize;
+    m_TileBuffer.resize(row * tile.height);
 
-    /* Copy new pixels */
-    if (void* iptr = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY))
+    for (int y = 0; y < tile.height; ++y)
     {
-        memcpy(iptr, image->Pixels(), image->FrameSize());
-        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        const std::size_t offset = (static_cast<std::size_t>(tile.y + y) * m_TiledWidth + tile.x) * m_PixelSize;
+        std::memcpy(m_TileBuffer.data() + y * row, m_TiledPixels + offset, row);
     }
 
-    // int size = 0;
-    // glGetBufferParameteriv(GL_PIXEL_UNPACK_BUFFER, GL_BUFFER_SIZE, &size);
-    // VOID_LOG_INFO("Size: {0}, FrameSize: {1}", size, image->FrameSize());
-    // assert(size >= image->FrameSize());
+    m_Pool->Upload(tile.texture, key, m_TileBuffer.data(), m_TileBuffer.size());
+    tile.loaded = true;
+}
 
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image->Width(), image->Height(), image->GLFormat(), image->GLType(), 0);
+void ImageRenderLayer::SetOperators(const std::vector<ImageOp*>& operators)
+{
+    std::vector<ParamSnapshot> params;
+    params.reserve(operators.size());
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    for (ImageOp* op : operators)
+        params.push_back(op->Snapshot());
 
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    SetOperators(operators, params);
+}
 
-    m_InputColorSpace = static_cast<int>(image->InputColorSpace());
+void ImageRenderLayer::SetOperators(const std::vector<ImageOp*>& operators, const std::vector<ParamSnapshot>& params)
+{
+    /* The shader is only rebuilt when drawing as that's when the context is current */
+    if (m_Shader.SetOperators(operators))
+        m_OperatorsChanged = true;
+
+    /* Values in the same order as the uniforms were declared */
+    m_OperatorValues.clear();
+    m_TexTransform = TextureTransform();
+
+    for (std::size_t i = 0; i < operators.size() && i < params.size(); ++i)
+    {
+        /* The last of the operators applies first on the coordinates */
+        if (operators[i]->Geometric())
+        {
+            m_TexTransform = m_TexTransform * operators[i]->Geometry(params[i]);
+            continue;
+        }
+
+        /* The snapshot has a value for each of the params, in the order they were added */
+        const std::vector<Param*>& p = operators[i]->Params();
+
+        for (std::size_t j = 0; j < p.size(); ++j)
+        {
+            switch (p[j]->type)
+            {
+                case Param::TypeDesc::Int: m_OperatorValues.push_back(params[i].Int(j)); break;
+                case Param::TypeDesc::Float: m_OperatorValues.push_back(params[i].Float(j)); break;
+                case Param::TypeDesc::Boolean: m_OperatorValues.push_back(params[i].Bool(j)); break;
+                case Param::TypeDesc::String: break;
+            }
+        }
+    }
 }
 
 void ImageRenderLayer::Render(const glm::mat4& projection, float, float)
@@ -138,6 +311,11 @@ void ImageRenderLayer::ReinitShaderProgram()
     m_Shader.Reinitialize();
 
     /* Re-Load all the locations for uniforms */
+    LoadUniforms();
+}
+
+void ImageRenderLayer::LoadUniforms()
+{
     m_UProjection = glGetUniformLocation(m_Shader.ProgramId(), "uMVP");
     m_UTexture = glGetUniformLocation(m_Shader.ProgramId(), "uTexture");
     m_UExposure = glGetUniformLocation(m_Shader.ProgramId(), "exposure");
@@ -145,6 +323,12 @@ void ImageRenderLayer::ReinitShaderProgram()
     m_UGain = glGetUniformLocation(m_Shader.ProgramId(), "gain");
     m_UChannelMode = glGetUniformLocation(m_Shader.ProgramId(), "channelMode");
     m_UInputColorSpace = glGetUniformLocation(m_Shader.ProgramId(), "inputColorSpace");
+    m_UChannels = glGetUniformLocation(m_Shader.ProgramId(), "channels");
+    m_UTexTransform = glGetUniformLocation(m_Shader.ProgramId(), "uTexTransform");
+
+    m_UOperators.clear();
+    for (const std::string& uniform : m_Shader.OperatorUniforms())
+        m_UOperators.push_back(glGetUniformLocation(m_Shader.ProgramId(), uniform.c_str()));
 }
 
 void ImageRenderLayer::SetupBuffers()
@@ -193,9 +377,6 @@ void ImageRenderLayer::SetupBuffers()
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
-    /* PBOs */
-    glGenBuffers(2, m_PBOs);
-
     /* Unbind */
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
@@ -204,6 +385,13 @@ void ImageRenderLayer::SetupBuffers()
 
 bool ImageRenderLayer::PreDraw()
 {
+    /* Operators have changed since the last draw */
+    if (m_OperatorsChanged)
+    {
+        ReinitShaderProgram();
+        m_OperatorsChanged = false;
+    }
+
     /* Use the Shader Program */
     m_Shader.Bind();
 
@@ -218,8 +406,8 @@ bool ImageRenderLayer::PreDraw()
 void ImageRenderLayer::Draw()
 {
     glActiveTexture(GL_TEXTURE0);
-    /* Bind the Generated texture for Render */
-    glBindTexture(GL_TEXTURE_2D, m_Texture);
+    /* Bind the texture holding the image */
+    glBindTexture(GL_TEXTURE_2D, m_ActiveTexture);
 
     /* Tell the shader what texture to use */
     glUniform1i(m_UTexture, 0);
@@ -245,6 +433,28 @@ void ImageRenderLayer::Draw()
      * view tranform for the viewer
      */
     glUniform1i(m_UInputColorSpace, m_InputColorSpace);
+    glUniform1i(m_UChannels, m_Channels);
+
+    /* Params of the operators */
+    for (std::size_t i = 0; i < m_UOperators.size() && i < m_OperatorValues.size(); ++i)
+    {
+        const ValueType& value = m_OperatorValues[i];
+
+        if (const float* f = std::get_if<float>(&value))
+            glUniform1f(m_UOperators[i], *f);
+        else if (const int* n = std::get_if<int>(&value))
+            glUniform1i(m_UOperators[i], *n);
+        else if (const bool* b = std::get_if<bool>(&value))
+            glUniform1i(m_UOperators[i], *b);
+    }
+
+    if (!m_Tiles.empty())
+    {
+        DrawTiles();
+        return;
+    }
+
+    ImageShaderProgram::LoadTransform(m_UTexTransform, m_TexTransform);
 
     /**
      * Draw triangles as bound in the Index buffer as defined earlier
@@ -260,6 +470,57 @@ void ImageRenderLayer::Draw()
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 }
 
+void ImageRenderLayer::DrawTiles()
+{
+    /* The tiles are sampled as they are, the geometric operators move the tiles instead */
+    ImageShaderProgram::LoadTransform(m_UTexTransform, TextureTransform());
+
+    /* Where on the quad does a coordinate of the image end up */
+    const TextureTransform inverse = Inverse(m_TexTransform);
+
+    for (Tile& tile : m_Tiles)
+    {
+        /* Coordinates of the tile onto the coordinates of the image */
+        const TextureTransform region(
+            static_cast<float>(tile.width) / m_TiledWidth, 0.f, static_cast<float>(tile.x) / m_TiledWidth,
+            0.f, static_cast<float>(tile.height) / m_TiledHeight, static_cast<float>(tile.y) / m_TiledHeight
+        );
+
+        /* Positions of the quad onto where the tile gets drawn */
+        const TextureTransform t = s_CoordToPosition * inverse * region * s_PositionToCoord;
+        const float* m = t.m;
+
+        glm::mat4 model(1.f);
+        model[0] = glm::vec4(m[0], m[3], 0.f, 0.f);
+        model[1] = glm::vec4(m[1], m[4], 0.f, 0.f);
+        model[3] = glm::vec4(m[2], m[5], 0.f, 1.f);
+
+        const glm::mat4 mvp = m_Projection * model;
+
+        /* Bounds of the tile in the viewport */
+        glm::vec2 lower(1e9f), upper(-1e9f);
+
+        for (const glm::vec2& corner : {glm::vec2(-1.f, -1.f), glm::vec2(1.f, -1.f), glm::vec2(1.f, 1.f), glm::vec2(-1.f, 1.f)})
+        {
+            const glm::vec4 p = mvp * glm::vec4(corner, 0.f, 1.f);
+            lower = glm::min(lower, glm::vec2(p));
+            upper = glm::max(upper, glm::vec2(p));
+        }
+
+        /* Tiles outside the viewport aren't uploaded at all */
+        if (upper.x < -1.f || lower.x > 1.f || upper.y < -1.f || lower.y > 1.f)
+            continue;
+
+        if (!tile.loaded)
+            LoadTile(tile);
+
+        glBindTexture(GL_TEXTURE_2D, tile.texture);
+        glUniformMatrix4fv(m_UProjection, 1, GL_FALSE, glm::value_ptr(mvp));
+
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    }
+}
+
 void ImageRenderLayer::PostDraw()
 {
     /* Cleanup */
@@ -4,25 +4,87 @@
 #ifndef _VOID_IMAGE_RENDER_LAYER_H
 #define _VOID_IMAGE_RENDER_LAYER_H
 
+/* STD */
+#include <cstddef>
+#include <vector>
+
 /* Internal */
 #include "Definition.h"
+#include "Operator.h"
 #include "PixReader.h"
 #include "VoidRenderer/Core/RenderTypes.h"
+#include "VoidRenderer/Core/TexturePool.h"
 #include "VoidRenderer/Programs/ImageShaderProgram.h"
 
 VOID_NAMESPACE_OPEN
 
+/**
+ * @brief Draws the image being viewed.
+ * Images larger than what a single texture can hold are split into tiles, of which only the ones
+ * visible at the current pan/zoom get uploaded.
+ */
 class ImageRenderLayer
 {
+    /* Part of an image too large for a single texture */
+    struct Tile
+    {
+        /* Region of the image (pixels) */
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+
+        /* Texture from the pool and the storage it has been acquired for */
+        unsigned int texture = 0;
+        TextureKey key;
+        /* Whether the texture holds the tile of the current image */
+        bool loaded = false;
+    };
+
 public:
     ImageRenderLayer();
     ~ImageRenderLayer();
 
-    /* Sets up the Render Components (Gears) */
-    void Initialize();
+    /* Sets up the Render Components (Gears), textures for the images come from the pool */
+    void Initialize(TexturePool& pool);
 
     void Reset();
-    void SetImage(const SharedPixels& image);
+
+    /**
+     * @brief Uploads the image onto the render texture to be displayed.
+     *
+     * @param image Image to be displayed.
+     * @param factor The image is downscaled by this factor before being uploaded, when it's displayed smaller than it is.
+     */
+    void SetImage(const SharedPixels& image, int factor = 1);
+
+    /**
+     * @brief Displays the image from a texture it has already been uploaded onto (ahead of being displayed).
+     *
+     * @param image The image which has been uploaded.
+     * @param texture Texture holding the pixels of the image.
+     */
+    void SetTexture(const SharedPixels& image, unsigned int texture);
+
+    /**
+     * @brief Set the operators to be applied on the image while drawing.
+     * The values of the params are read at this point, the shader gets rebuilt on the next draw only if
+     * the operators themselves have changed, changes to the values only update the uniforms.
+     * Geometric operators are combined into the transform of the texture coordinates, so mirroring the image
+     * doesn't touch the pixels at all.
+     *
+     * @param operators Operators (all of which are drawable) in the order of evaluation.
+     */
+    void SetOperators(const std::vector<ImageOp*>& operators);
+
+    /**
+     * @brief Set the operators to be applied on the image while drawing, with the values of their params taken earlier.
+     * The values aren't read from the operators, so these can be drawn away from the thread where the params are edited.
+     *
+     * @param operators Operators (all of which are drawable) in the order of evaluation.
+     * @param params Snapshots of the params of the operators, in the same order.
+     */
+    void SetOperators(const std::vector<ImageOp*>& operators, const std::vector<ParamSnapshot>& params);
 
     /* Set Attributes for Render */
     inline void SetExposure(const float exposure) { m_Exposure = exposure; }
@@ -51,6 +113,14 @@ private: /* Members */
     float m_Gain;
     int m_ChannelMode;
     int m_InputColorSpace;
+    int m_Channels;
+
+    /* Values for the params of the operators and whether the shader needs to be rebuilt for them */
+    std::vector<ValueType> m_OperatorValues;
+    bool m_OperatorsChanged;
+
+    /* Combined transform of the geometric operators */
+    TextureTransform m_TexTransform;
 
     /* Render Components */
     ImageShaderProgram m_Shader;
@@ -65,8 +135,6 @@ private: /* Members */
     unsigned int m_VAO;
     unsigned int m_VBO;
     unsigned int m_IBO;
-    unsigned int m_PBOs[2];
-    int m_PBOIndex;
 
     /* Uniforms */
     int m_UProjection;
@@ -76,18 +144,58 @@ private: /* Members */
     int m_UGain;
     int m_UChannelMode;
     int m_UInputColorSpace;
+    int m_UChannels;
+    int m_UTexTransform;
+    std::vector<int> m_UOperators;
 
-    /* Render Texture */
+    /* Render Texture and the storage it has been acquired for */
+    TexturePool* m_Pool;
     unsigned int m_Texture;
-    unsigned int m_InternalFormat;
+    TextureKey m_Key;
+    /* Texture being drawn, either the render texture or one the image was uploaded onto ahead */
+    unsigned int m_ActiveTexture;
+
+    /* Largest width or height of a texture */
+    int m_MaxTextureSize;
+
+    /* Tiles of the image when it's too large for a single texture */
+    std::vector<Tile> m_Tiles;
+    SharedPixels m_TiledImage;
+    const std::byte* m_TiledPixels;
+    int m_TiledWidth;
+    int m_TiledHeight;
+    std::size_t m_PixelSize;
+
+    /* Pixels of the downscaled image and of the tile being uploaded */
+    std::vector<std::byte> m_Scaled;
+    std::vector<std::byte> m_TileBuffer;
 
 private: /* Methods */
     /**
-     * @brief Reinitializes and re-allocates the buffer data based on the image size.
-     * 
-     * @param image The image data to be loaded.
+     * @brief Loads the locations of all the uniforms from the shader program.
+     */
+    void LoadUniforms();
+
+    /**
+     * @brief Splits the image into tiles, textures of the previous image's tiles are kept if it had the same size.
+     * The tiles are only uploaded when they're drawn.
+     */
+    void SetTiles(const SharedPixels& image, int factor);
+
+    /**
+     * @brief Releases the textures of the tiles back to the pool.
+     */
+    void ReleaseTiles();
+
+    /**
+     * @brief Uploads the region of the image onto the texture of the tile.
+     */
+    void LoadTile(Tile& tile);
+
+    /**
+     * @brief Draws the tiles which are visible in the viewport, uploading the ones which haven't been yet.
      */
-    void ReinitBuffer(const SharedPixels& image);
+    void DrawTiles();
 
     /**
      * @brief Setup Array Buffers
@@ -1,6 +1,10 @@
 // Copyright (c) 2025 waaake
 // Licensed under the MIT License
 
+/* STD */
+#include <algorithm>
+#include <cstddef>
+
 /* Qt */
 #include <QFile>
 
@@ -17,9 +21,14 @@ StrokeRenderLayer::StrokeRenderLayer()
     : m_Annotation(nullptr)
     , m_VAO(0)
     , m_VBO(0)
+    , m_LiveVAO(0)
+    , m_LiveVBO(0)
     , m_UProjection(-1)
-    , m_UColor(-1)
-    , m_USize(-1)
+    , m_BatchedStrokes(0)
+    , m_Dirty(true)
+    , m_BatchedCount(0)
+    , m_LiveCount(0)
+    , m_LiveCapacity(0)
     , m_Color(1.f, 1.f, 1.f)
     , m_Drawing(false)
     , m_Size(0.004f)
@@ -28,6 +37,14 @@ StrokeRenderLayer::StrokeRenderLayer()
 
 StrokeRenderLayer::~StrokeRenderLayer()
 {
+    /* Deleted with the context current */
+    if (m_VAO)
+    {
+        glDeleteVertexArrays(1, &m_VAO);
+        glDeleteBuffers(1, &m_VBO);
+        glDeleteVertexArrays(1, &m_LiveVAO);
+        glDeleteBuffers(1, &m_LiveVBO);
+    }
 }
 
 void StrokeRenderLayer::DrawPoint(const glm::vec2& point)
@@ -45,6 +62,9 @@ void StrokeRenderLayer::DrawPoint(const glm::vec2& point)
         m_Annotation->current.color = m_Color;
         m_Annotation->current.thickness = m_Size;
 
+        /* Nothing of the new stroke is in the live buffer yet */
+        m_LiveCount = 0;
+
         return;
     }
 
@@ -92,6 +112,7 @@ void StrokeRenderLayer::EraseStroke(const glm::vec2& point)
 
     /* Erase if the point collides on the stroke */
     m_Annotation->strokes.erase(std::remove_if(m_Annotation->strokes.begin(), m_Annotation->strokes.end(), colliding), m_Annotation->strokes.end());
+    m_Dirty = true;
 }
 
 void StrokeRenderLayer::CommitStroke()
@@ -110,6 +131,8 @@ void StrokeRenderLayer::CommitStroke()
     /* Clear the Current Annotation */
     m_Annotation->current.Clear();
     m_Drawing = false;
+    m_Dirty = true;
+    m_LiveCount = 0;
 }
 
 void StrokeRenderLayer::Initialize()
@@ -122,8 +145,12 @@ void StrokeRenderLayer::Initialize()
 
     /* Load all the locations for uniforms */
     m_UProjection = glGetUniformLocation(m_Shader.ProgramId(), "uMVP");
-    m_UColor = glGetUniformLocation(m_Shader.ProgramId(), "uColor");
-    m_USize = glGetUniformLocation(m_Shader.ProgramId(), "uThickness");
+
+    /* Buffers (if any) belonged to the previous context */
+    m_Dirty = true;
+    m_BatchedCount = 0;
+    m_LiveCount = 0;
+    m_LiveCapacity = 0;
 }
 
 void StrokeRenderLayer::Render(const glm::mat4& projection, float, float)
@@ -142,21 +169,112 @@ void StrokeRenderLayer::SetupBuffers()
     glGenVertexArrays(1, &m_VAO);
     glGenBuffers(1, &m_VBO);
 
+    glGenVertexArrays(1, &m_LiveVAO);
+    glGenBuffers(1, &m_LiveVBO);
+
+    SetupAttributes(m_VAO, m_VBO);
+    SetupAttributes(m_LiveVAO, m_LiveVBO);
+}
+
+void StrokeRenderLayer::SetupAttributes(unsigned int vao, unsigned int vbo)
+{
     /* Bind */
-    glBindVertexArray(m_VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
 
     /* Positions */
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Renderer::AnnotatedVertex), nullptr);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(StrokeVertex), (void*)offsetof(StrokeVertex, position));
     glEnableVertexAttribArray(0);
 
     /* Normals */
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Renderer::AnnotatedVertex), nullptr);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(StrokeVertex), (void*)offsetof(StrokeVertex, normal));
     glEnableVertexAttribArray(1);
 
+    /* Color of the stroke */
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(StrokeVertex), (void*)offsetof(StrokeVertex, color));
+    glEnableVertexAttribArray(2);
+
+    /* Thickness of the stroke */
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(StrokeVertex), (void*)offsetof(StrokeVertex, thickness));
+    glEnableVertexAttribArray(3);
+
     /* Unbind */
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void StrokeRenderLayer::AppendVertices(const Renderer::Stroke& stroke, int from)
+{
+    for (int i = from; i < stroke.Size(); ++i)
+        m_Vertices.push_back({stroke.vertices[i].position, stroke.vertices[i].normal, stroke.color, stroke.thickness});
+}
+
+void StrokeRenderLayer::UpdateStrokes()
+{
+    if (!m_Dirty && m_Batched.lock() == m_Annotation && m_BatchedStrokes == m_Annotation->strokes.size())
+        return;
+
+    m_Vertices.clear();
+
+    for (const Renderer::Stroke& stroke : m_Annotation->strokes)
+    {
+        if (stroke.Empty())
+            continue;
+
+        /**
+         * Repeating the last vertex of the previous stroke and the first of this one gives triangles
+         * without any area joining the two, as each stroke has an even number of vertices this keeps
+         * the winding of the strips intact
+         */
+        if (!m_Vertices.empty())
+        {
+            const Renderer::AnnotatedVertex& first = stroke.vertices.front();
+
+            m_Vertices.push_back(m_Vertices.back());
+            m_Vertices.push_back({first.position, first.normal, stroke.color, stroke.thickness});
+        }
+
+        AppendVertices(stroke);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(StrokeVertex) * m_Vertices.size(), m_Vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_BatchedCount = static_cast<int>(m_Vertices.size());
+    m_Batched = m_Annotation;
+    m_BatchedStrokes = m_Annotation->strokes.size();
+    m_Dirty = false;
+}
+
+void StrokeRenderLayer::UpdateLiveStroke()
+{
+    const Renderer::Stroke& stroke = m_Annotation->current;
+
+    /* A new stroke has been started since */
+    if (stroke.Size() < m_LiveCount)
+        m_LiveCount = 0;
+
+    if (stroke.Size() == m_LiveCount)
+        return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_LiveVBO);
+
+    if (stroke.Size() > m_LiveCapacity)
+    {
+        /* Grown ahead so that the following points only get appended */
+        m_LiveCapacity = std::max(stroke.Size() * 2, 1024);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(StrokeVertex) * m_LiveCapacity, nullptr, GL_DYNAMIC_DRAW);
+        m_LiveCount = 0;
+    }
+
+    m_Vertices.clear();
+    AppendVertices(stroke, m_LiveCount);
+
+    glBufferSubData(GL_ARRAY_BUFFER, sizeof(StrokeVertex) * m_LiveCount, sizeof(StrokeVertex) * m_Vertices.size(), m_Vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_LiveCount = stroke.Size();
 }
 
 bool StrokeRenderLayer::PreDraw()
@@ -164,11 +282,6 @@ bool StrokeRenderLayer::PreDraw()
     /* Use the Shader Program */
     m_Shader.Bind();
 
-    /* Bind the Vertex Array */
-    glBindVertexArray(m_VAO);
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-
     /* Enable MultiSample to allow smoothness of annotated lines */
     glEnable(GL_MULTISAMPLE);
 
@@ -180,27 +293,23 @@ void StrokeRenderLayer::Draw()
     /* Update the Projection matrix */
     glUniformMatrix4fv(m_UProjection, 1, GL_FALSE, glm::value_ptr(m_Projection));
 
-    /* Draw out the existing stokes */
-    for (const Renderer::Stroke& stroke: m_Annotation->strokes)
-        DrawStroke(stroke);
+    /* Draw out the existing stokes, all at once */
+    UpdateStrokes();
+
+    if (m_BatchedCount)
+    {
+        glBindVertexArray(m_VAO);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, m_BatchedCount);
+    }
 
     /* Draw out the current stroke */
     if (!m_Annotation->current.Empty())
-        DrawStroke(m_Annotation->current);
-}
-
-void StrokeRenderLayer::DrawStroke(const Renderer::Stroke& stroke)
-{
-    /* Update uniforms */
-    glUniform3fv(m_UColor, 1, glm::value_ptr(stroke.color));
-    glUniform1f(m_USize, stroke.thickness);
-
-    /* Update the data on the buffer */
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(Renderer::AnnotatedVertex) * stroke.Size(), stroke.Data(), GL_DYNAMIC_DRAW);
+    {
+        UpdateLiveStroke();
 
-    /* Draw the strokes as Triangle strip with stroke thickness */
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, stroke.Size());
+        glBindVertexArray(m_LiveVAO);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, m_LiveCount);
+    }
 }
 
 void StrokeRenderLayer::PostDraw()
@@ -8,6 +8,7 @@
 #include <GL/glew.h>
 
 /* STD */
+#include <memory>
 #include <vector>
 
 /* GLM */
@@ -22,8 +23,23 @@
 
 VOID_NAMESPACE_OPEN
 
+/**
+ * @brief Draws the strokes of an annotation.
+ *
+ * The committed strokes are packed into a single vertex buffer, which only gets rebuilt when the strokes change,
+ * and drawn with one call, the color and thickness of each stroke coming in with its vertices.
+ * The stroke being drawn lives in a buffer of its own which only gets the newly added vertices appended.
+ */
 class StrokeRenderLayer
 {
+    /* Vertex of a stroke along with the attributes of the stroke */
+    struct StrokeVertex
+    {
+        glm::vec2 position;
+        glm::vec2 normal;
+        glm::vec3 color;
+        float thickness;
+    };
 
 public:
     StrokeRenderLayer();
@@ -54,7 +70,7 @@ public:
      * This will result in nothing being drawn on the viewport
      */
     inline void DeleteAnnotation() { m_Annotation = nullptr; }
-    inline void SetAnnotation(const Renderer::SharedAnnotation& annotation) { m_Annotation = annotation; }
+    inline void SetAnnotation(const Renderer::SharedAnnotation& annotation) { m_Annotation = annotation; m_LiveCount = 0; }
     
     /**
      * Attributes Setters
@@ -72,14 +88,31 @@ private: /* Members */
 
     glm::mat4 m_Projection;
 
-    /* Array Buffers */
+    /* Array Buffers for the committed strokes */
     unsigned int m_VAO;
     unsigned int m_VBO;
 
+    /* Array Buffers for the stroke being drawn */
+    unsigned int m_LiveVAO;
+    unsigned int m_LiveVBO;
+
     /* Uniforms */
     int m_UProjection;
-    int m_UColor;
-    int m_USize;
+
+    /* Annotation and the number of its strokes the committed buffer was built for */
+    std::weak_ptr<Renderer::Annotation> m_Batched;
+    std::size_t m_BatchedStrokes;
+    /* Set when the strokes are changed by the layer itself */
+    bool m_Dirty;
+    /* Vertices in the committed buffer */
+    int m_BatchedCount;
+
+    /* Vertices of the stroke being drawn which are in the live buffer and how many it can hold */
+    int m_LiveCount;
+    int m_LiveCapacity;
+
+    /* Staging for the vertices to be uploaded */
+    std::vector<StrokeVertex> m_Vertices;
 
     glm::vec2 m_LastPoint;
     glm::vec3 m_Color;
@@ -118,11 +151,25 @@ private: /* Methods */
     void PostDraw();
 
     /**
-     * @brief Draws the current stroke on the gl buffer
-     * 
-     * @param stroke The Stroke to be rendererd.
+     * @brief Sets up the attributes of a StrokeVertex on the buffer for the vertex array.
+     */
+    void SetupAttributes(unsigned int vao, unsigned int vbo);
+
+    /**
+     * @brief Appends the vertices of the stroke (from the given one on) with the attributes of the stroke.
+     */
+    void AppendVertices(const Renderer::Stroke& stroke, int from = 0);
+
+    /**
+     * @brief Packs all the committed strokes into the buffer if they've changed since it was last built.
+     * The strokes are joined into one triangle strip with degenerate triangles between them.
+     */
+    void UpdateStrokes();
+
+    /**
+     * @brief Uploads the vertices of the stroke being drawn which have been added since the last draw.
      */
-    void DrawStroke(const Renderer::Stroke& stroke);
+    void UpdateLiveStroke();
 };
 
 VOID_NAMESPACE_CLOSE
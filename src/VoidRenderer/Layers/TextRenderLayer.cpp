@@ -44,6 +44,20 @@ TextAnnotationsRenderLayer::TextAnnotationsRenderLayer()
 
 TextAnnotationsRenderLayer::~TextAnnotationsRenderLayer()
 {
+    /* Deleted with the context current */
+    for (auto& [_, annotation] : m_Geometry)
+    {
+        for (TextGeometry& geometry : annotation.texts)
+            DeleteGeometry(geometry);
+    }
+
+    if (m_VAO)
+    {
+        glDeleteVertexArrays(1, &m_VAO);
+        glDeleteBuffers(1, &m_VBO);
+        glDeleteVertexArrays(1, &m_BoxVAO);
+        glDeleteBuffers(1, &m_BoxVBO);
+    }
 }
 
 void TextAnnotationsRenderLayer::Begin(const glm::vec2& position)
@@ -72,6 +86,14 @@ void TextAnnotationsRenderLayer::Begin(const glm::vec2& position)
             m_Typing = true;
             m_EditText = m_Annotation->draft.text;
 
+            /* The text is drawn as the draft while it's being edited */
+            std::vector<TextGeometry>& geometry = Geometry(m_Annotation);
+            if (i < geometry.size())
+            {
+                DeleteGeometry(geometry[i]);
+                geometry.erase(geometry.begin() + i);
+            }
+
             // This does invalidate the iterator, so the last step before returning
             m_Annotation->texts.erase(m_Annotation->texts.begin() + i);
             return;
@@ -205,8 +227,8 @@ void TextAnnotationsRenderLayer::Initialize()
     /* Initialize the Array Buffers */
     SetupBuffers();
 
-    /* Reinit Textures */
-    FontEngine::Instance().ClearTextures();
+    /* Any cached geometry belonged to the previous context */
+    m_Geometry.clear();
 
     /* Load all the locations for uniforms */
     m_UProjection = glGetUniformLocation(m_Shader.ProgramId(), "uMVP");
@@ -293,15 +315,51 @@ void TextAnnotationsRenderLayer::Draw()
 {
     glUniformMatrix4fv(m_UProjection, 1, GL_FALSE, glm::value_ptr(m_Projection));
 
-    for (const Renderer::RenderText& text: m_Annotation->texts)
-        DrawText(text);
+    /* Geometry of annotations which have gone away */
+    PruneGeometry();
+
+    std::vector<TextGeometry>& geometry = Geometry(m_Annotation);
+
+    /* Geometry of texts which have gone away */
+    while (geometry.size() > m_Annotation->texts.size())
+    {
+        DeleteGeometry(geometry.back());
+        geometry.pop_back();
+    }
+
+    geometry.resize(m_Annotation->texts.size());
+
+    for (std::size_t i = 0; i < m_Annotation->texts.size(); ++i)
+        DrawText(m_Annotation->texts[i], geometry[i]);
 
     /* Draw the Currently being typed text */
     if (m_Annotation->draft.Active())
+    {
+        /* The draft is drawn glyph by glyph from the shared buffer */
+        glBindVertexArray(m_VAO);
         DrawCurrent(m_Annotation->draft);
+    }
+}
+
+void TextAnnotationsRenderLayer::DrawText(const Renderer::RenderText& text, TextGeometry& geometry)
+{
+    if (geometry.text != text.text || geometry.size != text.size || geometry.position != text.position || geometry.scalex != m_Scalex || !geometry.vao)
+        BuildGeometry(text, geometry);
+
+    FontAtlas& atlas = FontStore::Instance().Atlas(text.size);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, atlas.TextureId());
+
+    /* Set the Color and the text to be used */
+    glUniform3fv(m_UColor, 1, glm::value_ptr(text.color));
+    glUniform1i(m_UText, 0);
+
+    glBindVertexArray(geometry.vao);
+    glDrawArrays(GL_TRIANGLES, 0, geometry.count);
 }
 
-void TextAnnotationsRenderLayer::DrawText(const Renderer::RenderText& text)
+void TextAnnotationsRenderLayer::BuildGeometry(const Renderer::RenderText& text, TextGeometry& geometry)
 {
     /* Beginning Position */
     float x = text.position.x;
@@ -334,17 +392,74 @@ void TextAnnotationsRenderLayer::DrawText(const Renderer::RenderText& text)
         x += fc.advance * m_Scalex;
     }
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, atlas.TextureId());
+    if (!geometry.vao)
+    {
+        glGenVertexArrays(1, &geometry.vao);
+        glGenBuffers(1, &geometry.vbo);
 
-    /* Set the Color and the text to be used */
-    glUniform3fv(m_UColor, 1, glm::value_ptr(text.color));
-    glUniform1i(m_UText, 0);
+        glBindVertexArray(geometry.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, geometry.vbo);
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_DYNAMIC_DRAW);
+        /* (location 0) position */
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+
+        /* (Location 1) texCoord */
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+
+        glBindVertexArray(0);
+    }
+    else
+        glBindBuffer(GL_ARRAY_BUFFER, geometry.vbo);
+
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    geometry.count = static_cast<int>(6 * text.text.size());
+    geometry.text = text.text;
+    geometry.size = text.size;
+    geometry.position = text.position;
+    geometry.scalex = m_Scalex;
+}
+
+void TextAnnotationsRenderLayer::DeleteGeometry(TextGeometry& geometry)
+{
+    if (geometry.vbo)
+        glDeleteBuffers(1, &geometry.vbo);
+
+    if (geometry.vao)
+        glDeleteVertexArrays(1, &geometry.vao);
 
-    glDrawArrays(GL_TRIANGLES, 0, 6 * text.text.size());
+    geometry = TextGeometry();
+}
+
+std::vector<TextAnnotationsRenderLayer::TextGeometry>& TextAnnotationsRenderLayer::Geometry(const Renderer::SharedAnnotation& annotation)
+{
+    AnnotationGeometry& entry = m_Geometry[annotation.get()];
+
+    /* The address could have belonged to an annotation deleted since, its geometry gets rebuilt as it won't match */
+    if (entry.annotation.lock() != annotation)
+        entry.annotation = annotation;
+
+    return entry.texts;
+}
+
+void TextAnnotationsRenderLayer::PruneGeometry()
+{
+    for (auto it = m_Geometry.begin(); it != m_Geometry.end();)
+    {
+        if (!it->second.annotation.expired())
+        {
+            ++it;
+            continue;
+        }
+
+        for (TextGeometry& geometry : it->second.texts)
+            DeleteGeometry(geometry);
+
+        it = m_Geometry.erase(it);
+    }
 }
 
 void TextAnnotationsRenderLayer::DrawCurrent(Renderer::RenderText& text)
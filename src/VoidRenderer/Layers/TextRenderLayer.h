@@ -8,6 +8,9 @@
 #include <GL/glew.h>
 
 /* STD */
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 /* Freetype */
@@ -29,6 +32,32 @@ VOID_NAMESPACE_OPEN
 
 class TextAnnotationsRenderLayer
 {
+    /**
+     * Glyph quads of a committed text, kept on the GPU and only rebuilt when the text
+     * (or how it's laid out) has changed since
+     */
+    struct TextGeometry
+    {
+        unsigned int vao = 0;
+        unsigned int vbo = 0;
+        int count = 0;
+
+        /* What the geometry was built for */
+        std::string text;
+        std::size_t size = 0;
+        glm::vec2 position = glm::vec2(0.f);
+        float scalex = 0.f;
+    };
+
+    /**
+     * Geometry of all the committed texts of an annotation, in the same order as its texts
+     * the annotation is only weakly referenced, its geometry goes away once the annotation does
+     */
+    struct AnnotationGeometry
+    {
+        std::weak_ptr<Renderer::Annotation> annotation;
+        std::vector<TextGeometry> texts;
+    };
 
 public:
     TextAnnotationsRenderLayer();
@@ -128,13 +157,25 @@ private: /* Members */
 
     std::string m_EditText;
 
+    /**
+     * Geometry of the committed texts for each of the annotations which have been drawn, so that switching between
+     * annotated frames (as during playback) draws from what was built earlier instead of rebuilding it
+     */
+    std::unordered_map<const Renderer::Annotation*, AnnotationGeometry> m_Geometry;
+
 private: /* Members */
     void SetupBuffers();
     bool PreDraw();
     void Draw();
     void PostDraw();
 
-    void DrawText(const Renderer::RenderText& text);
+    void DrawText(const Renderer::RenderText& text, TextGeometry& geometry);
+    void BuildGeometry(const Renderer::RenderText& text, TextGeometry& geometry);
+    void DeleteGeometry(TextGeometry& geometry);
+    /* Returns the geometry for the texts of the annotation, creating it if not present */
+    std::vector<TextGeometry>& Geometry(const Renderer::SharedAnnotation& annotation);
+    /* Deletes the geometry of annotations which don't exist anymore */
+    void PruneGeometry();
     void DrawCurrent(Renderer::RenderText& text);
     void DrawChar(char& c, float& x, float y);
     void DrawCaret(float x, float y);
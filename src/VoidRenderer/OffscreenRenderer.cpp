@@ -0,0 +1,263 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+/* STD */
+#include <cstring>
+
+/* GLM */
+#include <glm/mat4x4.hpp>
+
+/* Qt */
+#include <QThread>
+
+/* Internal */
+#include "OffscreenRenderer.h"
+#include "VoidCore/Logging.h"
+
+VOID_NAMESPACE_OPEN
+
+OffscreenRenderer::OffscreenRenderer()
+    : m_Context(nullptr)
+    , m_FBO(0)
+    , m_RBO(0)
+    , m_Width(0)
+    , m_Height(0)
+{
+    /* The surface needs to be created on the GUI thread */
+    m_Surface = new QOffscreenSurface;
+    m_Surface->setFormat(QSurfaceFormat::defaultFormat());
+    m_Surface->create();
+}
+
+OffscreenRenderer::~OffscreenRenderer()
+{
+    Release();
+
+    /* Deleted from the GUI thread, which it was created on */
+    m_Surface->deleteLater();
+    m_Surface = nullptr;
+}
+
+bool OffscreenRenderer::MakeCurrent()
+{
+    if (m_Context)
+    {
+        /* Only a context without a thread can be pulled onto this one, which is how it's left after each use */
+        if (m_Context->thread() != QThread::currentThread())
+            m_Context->moveToThread(QThread::currentThread());
+
+        return m_Context->thread() == QThread::currentThread() && m_Context->makeCurrent(m_Surface);
+    }
+
+    m_Context = new QOpenGLContext;
+    m_Context->setFormat(m_Surface->format());
+
+    /* The font atlases belong to the share group of the application's contexts */
+    if (QOpenGLContext* share = QOpenGLContext::globalShareContext())
+        m_Context->setShareContext(share);
+
+    if (!m_Context->create() || !m_Context->makeCurrent(m_Surface))
+    {
+        VOID_LOG_ERROR("Unable to create the offscreen render context.");
+
+        delete m_Context;
+        m_Context = nullptr;
+        return false;
+    }
+
+    /* Nothing might have initialized GLEW yet when rendering without a viewer */
+    unsigned int status = glewInit();
+
+    if (status != GLEW_OK)
+    {
+        VOID_LOG_ERROR("GLEW init Failed: {0}", reinterpret_cast<const char*>(glewGetErrorString(status)));
+
+        /* Nothing has been created on the context yet */
+        m_Context->doneCurrent();
+        delete m_Context;
+        m_Context = nullptr;
+        return false;
+    }
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glClearColor(0.f, 0.f, 0.f, 1.f);
+
+    m_TexturePool = std::make_unique<TexturePool>();
+    m_ImageRenderer = std::make_unique<ImageRenderLayer>();
+    m_StrokeRenderer = std::make_unique<StrokeRenderLayer>();
+    m_TextRenderer = std::make_unique<TextAnnotationsRenderLayer>();
+
+    m_ImageRenderer->Initialize(*m_TexturePool);
+    m_StrokeRenderer->Initialize();
+    m_TextRenderer->Initialize();
+
+    return true;
+}
+
+void OffscreenRenderer::DoneCurrent()
+{
+    m_Context->doneCurrent();
+    m_Context->moveToThread(nullptr);
+}
+
+bool OffscreenRenderer::Resize(int width, int height)
+{
+    if (m_FBO && width == m_Width && height == m_Height)
+        return true;
+
+    DeleteFramebuffer();
+
+    glGenFramebuffers(1, &m_FBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+
+    glGenRenderbuffers(1, &m_RBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_RBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_RBO);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        VOID_LOG_ERROR("Offscreen framebuffer ({0}x{1}) is incomplete.", width, height);
+        DeleteFramebuffer();
+        return false;
+    }
+
+    m_Width = width;
+    m_Height = height;
+    return true;
+}
+
+void OffscreenRenderer::DeleteFramebuffer()
+{
+    if (m_FBO)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteFramebuffers(1, &m_FBO);
+    }
+
+    if (m_RBO)
+        glDeleteRenderbuffers(1, &m_RBO);
+
+    m_FBO = 0;
+    m_RBO = 0;
+    m_Width = 0;
+    m_Height = 0;
+}
+
+Renderer::RenderData<unsigned char> OffscreenRenderer::Render(
+    const SharedPixels& image,
+    const SharedAnnotation& annotation,
+    const std::vector<ImageOp*>& operators,
+    const std::vector<ParamSnapshot>& params
+)
+{
+    Renderer::RenderData<unsigned char> r{0, 0, 4, {}};
+
+    if (!image || image->Empty() || !MakeCurrent())
+        return r;
+
+    const int width = image->Width();
+    const int height = image->Height();
+
+    if (!Resize(width, height))
+    {
+        DoneCurrent();
+        return r;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+    glViewport(0, 0, width, height);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    /* The viewport has the aspect of the image, which fills it entirely */
+    const glm::mat4 projection(1.f);
+
+    m_ImageRenderer->SetImage(image);
+    /* Values are what the caller took, the params could be getting edited on another thread */
+    if (params.size() == operators.size())
+        m_ImageRenderer->SetOperators(operators, params);
+    else
+        m_ImageRenderer->SetOperators(operators);
+    m_ImageRenderer->Render(projection, width, height);
+
+    if (annotation)
+    {
+        m_StrokeRenderer->SetAnnotation(annotation);
+        m_TextRenderer->SetAnnotation(annotation);
+
+        m_StrokeRenderer->Render(projection, width, height);
+        m_TextRenderer->Render(projection, width, height);
+
+        m_StrokeRenderer->DeleteAnnotation();
+        m_TextRenderer->DeleteAnnotation();
+    }
+
+    glUseProgram(0);
+
+    r.width = width;
+    r.height = height;
+    r.pixels.resize(r.Size());
+
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, r.pixels.data());
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    DoneCurrent();
+
+    /* GL reads the bottom row first */
+    const std::size_t stride = static_cast<std::size_t>(width) * r.channels;
+    std::vector<unsigned char> row(stride);
+
+    for (int y = 0; y < height / 2; ++y)
+    {
+        unsigned char* top = r.pixels.data() + y * stride;
+        unsigned char* bottom = r.pixels.data() + (height - 1 - y) * stride;
+
+        std::memcpy(row.data(), top, stride);
+        std::memcpy(top, bottom, stride);
+        std::memcpy(bottom, row.data(), stride);
+    }
+
+    return r;
+}
+
+void OffscreenRenderer::Release()
+{
+    if (!m_Context)
+        return;
+
+    /**
+     * The context is left without a thread between renders, so it is pulled onto this thread and made current here
+     * whichever thread that is, for the layers and the pool to delete what they hold
+     */
+    if (!MakeCurrent())
+    {
+        /* Deleting these without a current context would make GL calls into whichever context is current, if any */
+        VOID_LOG_ERROR("Unable to make the offscreen render context current, its GL objects are left to the share group.");
+
+        m_TextRenderer.release();
+        m_StrokeRenderer.release();
+        m_ImageRenderer.release();
+        m_TexturePool.release();
+
+        m_Context->deleteLater();
+        m_Context = nullptr;
+        return;
+    }
+
+    DeleteFramebuffer();
+
+    /* Layers delete their shaders and buffers, the pool then deletes all the textures and staging buffers */
+    m_TextRenderer.reset();
+    m_StrokeRenderer.reset();
+    m_ImageRenderer.reset();
+    m_TexturePool.reset();
+
+    m_Context->doneCurrent();
+    delete m_Context;
+    m_Context = nullptr;
+}
+
+VOID_NAMESPACE_CLOSE
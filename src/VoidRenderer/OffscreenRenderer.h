@@ -0,0 +1,129 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+#ifndef _VOID_OFFSCREEN_RENDERER_H
+#define _VOID_OFFSCREEN_RENDERER_H
+
+/* GLEW */
+#include <GL/glew.h>
+
+/* STD */
+#include <memory>
+#include <vector>
+
+/* Qt */
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+
+/* Internal */
+#include "Definition.h"
+#include "PixReader.h"
+#include "Core/RenderTypes.h"
+#include "Core/TexturePool.h"
+#include "Layers/ImageRenderLayer.h"
+#include "Layers/StrokeRenderLayer.h"
+#include "Layers/TextRenderLayer.h"
+
+VOID_NAMESPACE_OPEN
+
+/**
+ * @brief Renders frames (image, effects, color transform and annotations) onto a framebuffer of its own
+ * and reads them back, without anything being displayed.
+ *
+ * The renderer has a context of its own, made current on whichever thread renders, which allows exports to run
+ * in the background alongside the viewer, or without any viewer at all (e.g. on the offscreen/eglfs platforms
+ * or a software rasterizer). The context shares objects with the application's global share context when there's one,
+ * which the font atlases (created by whichever context needs a glyph first) need to be drawn from here.
+ *
+ * Frames are rendered at the size of the image rather than the size of any viewport.
+ */
+class VOID_API OffscreenRenderer
+{
+    /* Render Types */
+    using SharedAnnotation = Renderer::SharedAnnotation;
+
+public:
+    /**
+     * The surface gets created here, so the renderer needs to be constructed on the GUI thread.
+     */
+    OffscreenRenderer();
+    ~OffscreenRenderer();
+
+    /* Disable Copy */
+    OffscreenRenderer(const OffscreenRenderer&) = delete;
+    OffscreenRenderer& operator=(const OffscreenRenderer&) = delete;
+
+    /**
+     * @brief Renders the image along with its annotation and returns the RGBA (8 bit) pixels, top row first.
+     * The context gets created on the first render, all the renders (and the Release) need to happen on that thread.
+     *
+     * @param image Image to be rendered.
+     * @param annotation Annotation (strokes and text) drawn over the image.
+     * @param operators Operators (with shaders) which get applied on the image while drawing.
+     * @param params Snapshots of the params of the operators (in the same order), taken where the params are edited.
+     * @return Renderer::RenderData<unsigned char> Rendered pixels, empty if the frame couldn't be rendered.
+     */
+    Renderer::RenderData<unsigned char> Render(
+        const SharedPixels& image,
+        const SharedAnnotation& annotation = nullptr,
+        const std::vector<ImageOp*>& operators = {},
+        const std::vector<ParamSnapshot>& params = {}
+    );
+
+    /**
+     * @brief Deletes the framebuffer, textures and the context, this can be called from any thread.
+     * The renderer can still be used afterwards, a new context gets created for the next render.
+     */
+    void Release();
+
+    /* Whether the renderer has a valid surface to render on */
+    inline bool Valid() const { return m_Surface->isValid(); }
+
+private: /* Members */
+    QOffscreenSurface* m_Surface;
+    QOpenGLContext* m_Context;
+
+    /* Framebuffer rendered onto and its color attachment */
+    unsigned int m_FBO;
+    unsigned int m_RBO;
+    int m_Width;
+    int m_Height;
+
+    /**
+     * Objects of the context live in the application's share group, and outlive the context, so these are
+     * created along with the context and destroyed (deleting what they hold) while it's still current
+     */
+    /* Textures and staging buffers of the image render layer */
+    std::unique_ptr<TexturePool> m_TexturePool;
+
+    std::unique_ptr<ImageRenderLayer> m_ImageRenderer;
+    std::unique_ptr<StrokeRenderLayer> m_StrokeRenderer;
+    std::unique_ptr<TextAnnotationsRenderLayer> m_TextRenderer;
+
+private: /* Methods */
+    /**
+     * Creates the context (and the render layers) if not done yet and makes it current
+     * the context is moved over to the calling thread for it to be made current there
+     */
+    bool MakeCurrent();
+
+    /**
+     * Done with the context for now, it is left without a thread so that whichever thread
+     * renders (or releases) next is able to make it current
+     */
+    void DoneCurrent();
+
+    /**
+     * (Re)Creates the framebuffer if the size has changed
+     */
+    bool Resize(int width, int height);
+
+    /**
+     * Deletes the framebuffer and its attachment
+     */
+    void DeleteFramebuffer();
+};
+
+VOID_NAMESPACE_CLOSE
+
+#endif // _VOID_OFFSCREEN_RENDERER_H
@@ -0,0 +1,126 @@
+// Copyright (c) 2025 waaake
+// Licensed under the MIT License
+
+/* STD */
+#include <string>
+
+/* GLEW */
+#include <GL/glew.h>
+
+/* Internal */
+#include "GridShaderProgram.h"
+#include "ImageShaderProgram.h"
+#include "VoidCore/Logging.h"
+#include "VoidCore/ColorProcessor.h"
+#include "VoidCore/VoidTools.h"
+
+VOID_NAMESPACE_OPEN
+
+static const char* s_VertexShaderSrc = R"(
+#version 330 core
+layout (location = 0) in vec2 position;
+layout (location = 1) in vec2 v_TexCoord;
+
+// Per cell
+// Center (xy) and half the size (zw) of the image in the cell
+layout (location = 2) in vec4 iRect;
+// Extent of the layer the image occupies (xy) and the layer (z)
+layout (location = 3) in vec3 iLayer;
+// Rows of the transform of the geometric operators
+layout (location = 4) in vec3 iTransformX;
+layout (location = 5) in vec3 iTransformY;
+layout (location = 6) in float iColorSpace;
+
+uniform mat4 uProjection;
+
+out vec2 TexCoord;
+flat out vec3 Layer;
+flat out int inputColorSpace;
+
+void main() {
+    gl_Position = uProjection * vec4(iRect.xy + position * iRect.zw, 0.0, 1.0);
+
+    vec3 coord = vec3(v_TexCoord, 1.0);
+    TexCoord = vec2(dot(iTransformX, coord), dot(iTransformY, coord));
+
+    Layer = iLayer;
+    inputColorSpace = int(iColorSpace);
+}
+)";
+
+/**
+ * The image is sampled from the layer of the cell, only within the part of it the image occupies
+ * as the layers are as large as the largest of the images
+ */
+static const char* s_SamplerSrc = R"(
+uniform sampler2DArray uTexture;
+
+flat in vec3 Layer;
+
+vec4 Sample(vec2 coord)
+{
+    // Clamped half a texel inside the image, as it would be by the edges of a texture of its own
+    vec2 texel = 0.5 / vec2(textureSize(uTexture, 0).xy);
+    return texture(uTexture, vec3(clamp(coord * Layer.xy, texel, Layer.xy - texel), Layer.z));
+}
+)";
+
+GridShaderProgram::~GridShaderProgram()
+{
+    m_Program->deleteLater();
+    delete m_Program;
+    m_Program = nullptr;
+}
+
+void GridShaderProgram::Initialize()
+{
+    m_Program = new QOpenGLShaderProgram;
+
+    /* Setup the Shaders */
+    SetupShaders();
+}
+
+bool GridShaderProgram::SetupShaders()
+{
+    /**
+     * Same as the fragment shader of the image, apart from where the pixels are sampled from
+     * and the colorspace coming in from the cell instead of a uniform
+     */
+    std::string fragmentShader = FragmentShader(ColorProcessor::Instance().Shader("OCIOViewerTransform"), "");
+
+    Tools::find_replace(fragmentShader, "uniform sampler2D uTexture;", s_SamplerSrc);
+    Tools::find_replace(fragmentShader, "uniform int inputColorSpace;", "flat in int inputColorSpace;");
+    Tools::find_replace(fragmentShader, "texture(uTexture, TexCoord)", "Sample(TexCoord)");
+
+    /* Add Shaders */
+    m_Program->addShaderFromSourceCode(QOpenGLShader::Vertex, s_VertexShaderSrc);
+    m_Program->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShader.c_str());
+
+    /* Try and Compile - Link Shaders */
+    if (!m_Program->link())
+    {
+        /* Log the Errors from the Program */
+        VOID_LOG_ERROR("Unable to Link Grid Shaders: {0}", m_Program->log().toStdString());
+        return false;
+    }
+
+    /* We're all good */
+    VOID_LOG_INFO("Grid Shaders Loaded.");
+    return true;
+}
+
+void GridShaderProgram::Reinitialize()
+{
+    /* Unbind */
+    Release();
+
+    /* Delete the current Program */
+    m_Program->deleteLater();
+    delete m_Program;
+    m_Program = nullptr;
+
+    /* Reinit */
+    Initialize();
+}
+
+VOID_NAMESPACE_CLOSE
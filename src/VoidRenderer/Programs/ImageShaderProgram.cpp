@@ -28,15 +28,27 @@ layout (location = 0) in vec2 position;
 layout (location = 1) in vec2 v_TexCoord;
 
 uniform mat4 uMVP;
+// Geometric operators, where each pixel gets sampled from
+uniform mat3 uTexTransform;
 out vec2 TexCoord;
 
 void main() {
     gl_Position = uMVP * vec4(position, 0.0, 1.0);
-    TexCoord = v_TexCoord;
+    TexCoord = (uTexTransform * vec3(v_TexCoord, 1.0)).xy;
 }
 )";
 
-std::string FragmentShader(const std::string& ocioShader)
+/**
+ * Operators (if any) are applied on the pixels as they are sampled from the texture
+ */
+static const char* s_DefaultOperatorShader = R"(
+vec4 OperateColor(vec4 color)
+{
+    return color;
+}
+)";
+
+std::string FragmentShader(const std::string& ocioShader, const std::string& operatorShader)
 {
     std::string fragmentShaderSrc = R"(
 #version 330 core
@@ -56,6 +68,9 @@ uniform int channelMode;
 // Input Colorspace
 uniform int inputColorSpace;
 
+// Number of channels in the image
+uniform int channels;
+
 float Rec709ToLinear(float value)
 {
     return (value <= 0.081) ? value / 4.5 : pow((value + 0.099) / 1.099, 1.0 / 0.45);
@@ -66,16 +81,19 @@ float SRGBToLinear(float value)
     return (value <= 0.04045) ? value / 12.92 : pow((value + 0.055) / 1.055, 2.4);
 }
 
+// ARRI LogC3 (EI 800), same as the transfer tables used when reading and writing
 float LogCToLinear(float value)
 {
     // Defined Constants
-    float cut = 0.149;
-    float offset = 0.385;
-    float gain = 5.555556;
-    float linearOffset = 0.0928;
-    float slope = 5.367655;
-
-    return (value < cut) ? ( value - linearOffset ) / slope : (pow(10.f, (value - offset)) - 1) / gain;
+    float cut = 0.010591;
+    float a = 5.555556;
+    float b = 0.052272;
+    float c = 0.247190;
+    float d = 0.385537;
+    float e = 5.367655;
+    float f = 0.092809;
+
+    return (value > e * cut + f) ? (pow(10.0, (value - d) / c) - b) / a : (value - f) / e;
 }
 
 vec3 inverseRec709(vec3 c)
@@ -129,11 +147,14 @@ vec4 Linearize(vec4 color, int colorspace)
     return color;
 }
 
+// OPERATOR SHADER PLACEHOLDER //
+
 // OCIO SHADER PLACEHOLDER //
 
 void main() {
-    // Texture pixel values from the buffers
-    vec4 color = texture(uTexture, TexCoord);
+    // Texture pixel values from the buffers, with the operators applied before anything else
+    // this is where they would have been evaluated if processed on the CPU
+    vec4 color = OperateColor(texture(uTexture, TexCoord));
 
     // Ensure we have linear output depending on the input colorspace
     vec4 linear = Linearize(color, inputColorSpace);
@@ -185,6 +206,9 @@ void main() {
     /* Add OCIO Shader in the source code */
     Tools::find_replace(fragmentShaderSrc, placeholder, ocioShader);
 
+    /* Add the Operators */
+    Tools::find_replace(fragmentShaderSrc, "// OPERATOR SHADER PLACEHOLDER //", operatorShader.empty() ? s_DefaultOperatorShader : operatorShader);
+
     return fragmentShaderSrc;
 }
 
@@ -211,7 +235,7 @@ bool ImageShaderProgram::SetupShaders()
      * The viewer tranform is based on the current display/view or input -> output colorspace
      * set on the ColorProcessor
      */
-    std::string fragmentShader = std::move(FragmentShader(ColorProcessor::Instance().Shader("OCIOViewerTransform")));
+    std::string fragmentShader = std::move(FragmentShader(ColorProcessor::Instance().Shader("OCIOViewerTransform"), m_OperatorShader));
 
     /* Add Shaders */
     m_Program->addShaderFromSourceCode(QOpenGLShader::Vertex, s_VertexShaderSrc);
@@ -230,6 +254,65 @@ bool ImageShaderProgram::SetupShaders()
     return true;
 }
 
+bool ImageShaderProgram::SetOperators(const std::vector<ImageOp*>& operators)
+{
+    std::string shader;
+    std::vector<std::string> uniforms;
+
+    std::string color = "vec4 OperateColor(vec4 color)\n{\n";
+
+    for (std::size_t i = 0; i < operators.size(); ++i)
+    {
+        /* Geometric operators are applied on the texture coordinates with the transform uniform */
+        if (operators[i]->Geometric())
+            continue;
+
+        const std::string name = "operator" + std::to_string(i);
+
+        for (const Param* param : operators[i]->Params())
+        {
+            const std::string uniform = name + "_" + param->name;
+
+            switch (param->type)
+            {
+                case Param::TypeDesc::Float: shader += "uniform float " + uniform + ";\n"; break;
+                case Param::TypeDesc::Int: shader += "uniform int " + uniform + ";\n"; break;
+                case Param::TypeDesc::Boolean: shader += "uniform bool " + uniform + ";\n"; break;
+                default: continue;
+            }
+
+            uniforms.push_back(uniform);
+        }
+
+        shader += operators[i]->Shader(name);
+        color += "    color = " + name + "(color);\n";
+    }
+
+    if (!shader.empty())
+        shader += color + "    return color;\n}\n";
+
+    if (shader == m_OperatorShader)
+        return false;
+
+    m_OperatorShader = std::move(shader);
+    m_OperatorUniforms = std::move(uniforms);
+    return true;
+}
+
+void ImageShaderProgram::LoadTransform(int location, const TextureTransform& transform)
+{
+    const float* m = transform.m;
+
+    /* Column major 3x3 for the affine 2x3 */
+    const float matrix[9] = {
+        m[0], m[3], 0.f,
+        m[1], m[4], 0.f,
+        m[2], m[5], 1.f
+    };
+
+    glUniformMatrix3fv(location, 1, GL_FALSE, matrix);
+}
+
 void ImageShaderProgram::Reinitialize()
 {
     /* Unbind */
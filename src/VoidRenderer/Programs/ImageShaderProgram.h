@@ -4,15 +4,28 @@
 #ifndef _VOID_IMAGE_SHADER_PROGRAM_H
 #define _VOID_IMAGE_SHADER_PROGRAM_H
 
+/* STD */
+#include <string>
+#include <vector>
+
 /* Qt */
 #include <QOpenGLShaderProgram>
 
 /* Internal */
 #include "Definition.h"
+#include "Operator.h"
 #include "ShaderProgram.h"
 
 VOID_NAMESPACE_OPEN
 
+/**
+ * @brief Returns the source of the fragment shader which displays an image.
+ *
+ * @param ocioShader Implementation of the OCIOViewerTransform function.
+ * @param operatorShader Implementation of the OperateColor function, the default passes the color through if empty.
+ */
+std::string FragmentShader(const std::string& ocioShader, const std::string& operatorShader);
+
 class ImageShaderProgram : public ShaderProgram
 {
 public:
@@ -44,6 +57,30 @@ public:
      */
     virtual inline void Release() override { m_Program->release(); }
 
+    /**
+     * @brief Sets the operators which get applied on the image before the viewer transform.
+     * Only the shader snippets of the operators are used here, the program needs to be reinitialized
+     * for any change to take effect. Geometric operators are left out as they're applied with the uTexTransform uniform.
+     *
+     * @param operators Operators to be applied, in the order they get evaluated.
+     * @return true if the generated shader has changed and the program needs to be reinitialized.
+     */
+    bool SetOperators(const std::vector<ImageOp*>& operators);
+
+    /**
+     * @brief Loads the transform of the geometric operators onto the uTexTransform uniform of the bound program.
+     *
+     * @param location Location of the uniform.
+     * @param transform Transformation of the texture coordinates.
+     */
+    static void LoadTransform(int location, const TextureTransform& transform);
+
+    /**
+     * Returns the names of the uniforms for the params of the operators, in the order of the operators
+     * and their params
+     */
+    inline const std::vector<std::string>& OperatorUniforms() const { return m_OperatorUniforms; }
+
 protected:
     /**
      * Setup Shaders
@@ -53,6 +90,10 @@ protected:
 
 private: /* Members */
     QOpenGLShaderProgram* m_Program;
+
+    /* Generated shader source for the operators and the uniforms it declares */
+    std::string m_OperatorShader;
+    std::vector<std::string> m_OperatorUniforms;
 };
 
 VOID_NAMESPACE_CLOSE
@@ -17,27 +17,28 @@ static const char* s_VertexShaderSrc = R"(
 #version 330 core
 layout (location = 0) in vec2 position;
 layout (location = 1) in vec2 normal;
+// Strokes are drawn together, each vertex carries the attributes of its stroke
+layout (location = 2) in vec3 color;
+layout (location = 3) in float thickness;
 
 uniform mat4 uMVP;
-uniform float uThickness;
 
-void main() {
-    // Offset by half of thickness
-    // vec2 offset = normal * uThickness * 0.5;
+out vec3 vColor;
 
-    // gl_Position = uMVP * vec4(position + offset, 0.0, 1.0);
+void main() {
+    // The vertices are already offset by half of the thickness along the normal when the stroke is drawn
     gl_Position = uMVP * vec4(position, 0.0, 1.0);
+    vColor = color;
 }
 )";
 
 static const char* s_FragmentShaderSrc = R"(
 #version 330 core
+in vec3 vColor;
 out vec4 FragColor;
 
-uniform vec3 uColor;
-
 void main() {
-    FragColor = vec4(uColor, 1.0);
+    FragColor = vec4(vColor, 1.0);
 }
 )";
 
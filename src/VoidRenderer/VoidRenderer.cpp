@@ -11,21 +11,30 @@
 #include <QMouseEvent>
 #include <QPainter>
 #include <QPixmap>
+#include <QTimer>
 
 /* Internal */
 #include "VoidRenderer.h"
+#include "Core/FontEngine.h"
 #include "VoidCore/ColorProcessor.h"
 #include "VoidCore/Logging.h"
 
 constexpr float MAX_ZOOM = 12.8;
 constexpr float MIN_ZOOM = 0.1;
 
+/* Largest factor the displayed image is downscaled by, 16x fewer pixels to be uploaded */
+constexpr int MAX_DISPLAY_FACTOR = 4;
+
+/* How often the pending pixel reads are checked on while nothing gets drawn (milliseconds) */
+constexpr int PROBE_INTERVAL = 16;
+
 VOID_NAMESPACE_OPEN
 
 VoidRenderer::VoidRenderer(QWidget* parent)
     : BasicRenderer(parent)
     , m_ImageA(nullptr)
     , m_ImageB(nullptr)
+    , m_ProbeScheduled(false)
     , m_CompareMode(ComparisonMode::NONE)
     , m_BlendMode(BlendMode::UNDER)
     , m_DrawType(DrawType::NONE)
@@ -35,37 +44,75 @@ VoidRenderer::VoidRenderer(QWidget* parent)
     , m_ZoomFactor(1.f)
     , m_TranslateX(0.f)
     , m_TranslateY(0.f)
+    , m_DisplayFactor(1)
     , m_Pressed(false)
     , m_Annotating(false)
     , m_Pan(0.f, 0.f)
 {
     setFocusPolicy(Qt::StrongFocus);
     installEventFilter(this);
+
+    /* Swaps onto the texture of the displayed image once the uploader has it at the current factor */
+    m_Uploader.SetReadyCallback([this](const SharedPixels& image)
+    {
+        QMetaObject::invokeMethod(this, [this, image]()
+        {
+            if (image != m_ImageA || m_CompareMode != ComparisonMode::NONE)
+                return;
+
+            LoadImage(m_ImageA);
+            update();
+        }, Qt::QueuedConnection);
+    });
 }
 
 VoidRenderer::~VoidRenderer()
 {
+    /* The render layers and the pool delete their buffers and textures when destroyed, which needs the context */
+    makeCurrent();
+
+    /* Nothing gets called back from the upload thread once the renderer is going */
+    m_Uploader.Release();
 }
 
 void VoidRenderer::Initialize()
 {
+    /* Any textures in the pool belonged to the previous context (if any) */
+    m_TexturePool.Initialize();
+
     /* Initialize the Image Render Layer */
-    m_ImageRenderer.Initialize();
+    m_ImageRenderer.Initialize(m_TexturePool);
     /* Initialize the Comparison Image Render Layer */
-    m_ImageComparisonRenderer.Initialize();
+    m_ImageComparisonRenderer.Initialize(m_TexturePool);
 
     m_SwipeRenderer.Initialize();
     m_StrokeRenderer.Initialize();
+
+    /**
+     * Reinit the glyph textures, these are shared by any offscreen renderers drawing text,
+     * so only the viewer (whose context they were created with) clears them
+     */
+    FontEngine::Instance().ClearTextures();
     m_TextRenderer.Initialize();
 
     m_GridRenderer.Initialize();
 
+    /* Any pixel reads pending were on the previous context */
+    m_PixelProbe.Initialize();
+
+    /* Uploads happen on a context sharing textures with the current one, which gets recreated when the widget is reparented */
+    m_Uploader.Initialize(context());
+
     /* (Re)Load Any textures if available */
     ReloadTextures();
 }
 
 void VoidRenderer::Draw()
 {
+    /* Reads of the previous frames have most likely completed by now */
+    if (m_PixelProbe.Pending())
+        FetchPixelProbe();
+
     if (m_CompareMode == ComparisonMode::GRID)
     {
         m_GridRenderer.Render(m_VProjection, width(), height());
@@ -81,6 +128,9 @@ void VoidRenderer::Draw()
         /* Render Layers */
         if (m_CompareMode == ComparisonMode::NONE)
         {
+            /* The zoom or the size of the viewport might have changed since the image was uploaded */
+            UpdateDisplayFactor();
+
             /* Render the Image Texture */
             m_ImageRenderer.Render(m_VProjection, width(), height());
 
@@ -289,16 +339,18 @@ void VoidRenderer::mouseMoveEvent(QMouseEvent* event)
     /* Update the X and Y Coordinates for the mouse movements */
     m_RenderStatus->SetMouseCoordinates(x, y);
 
-    /* Fetch color values at the given point */
-    float pixels[4] = { 0.f }; /* R G B A*/
-    #if _QT6
-    glReadPixels(event->globalPosition().x(), height() - y + pos().y(), 1, 1, GL_RGBA, GL_FLOAT, pixels);
-    #else
-    glReadPixels(event->globalX(), height() - y + pos().y(), 1, 1, GL_RGBA, GL_FLOAT, pixels);
-    #endif // _QT6
+    /**
+     * Queue the read of the color values at the given point, the framebuffer is in device pixels with its origin
+     * at the bottom left, the values are shown on the status bar once the GPU has read them back
+     */
+    const qreal ratio = devicePixelRatio();
+    const int px = std::clamp(static_cast<int>(x * ratio), 0, static_cast<int>(width() * ratio) - 1);
+    const int py = std::clamp(static_cast<int>((height() - 1 - y) * ratio), 0, static_cast<int>(height() * ratio) - 1);
 
-    /* Update the Pixel values on the Renderer Status bar */
-    m_RenderStatus->SetColourValues(pixels[0], pixels[1], pixels[2], pixels[3]);
+    makeCurrent();
+    m_PixelProbe.Read(px, py);
+    FetchPixelProbe();
+    doneCurrent();
 }
 
 void VoidRenderer::wheelEvent(QWheelEvent* event)
@@ -388,13 +440,14 @@ void VoidRenderer::Render(SharedPixels data)
     RemoveAnnotation();
 
     /* Load the Textures to be rendered */
-    m_ImageRenderer.SetImage(m_ImageA);
+    LoadImage(m_ImageA);
+    m_ImageRenderer.SetOperators({});
 
     /* Trigger a Re-paint */
     update();
 }
 
-void VoidRenderer::Render(const SharedPixels& data, const SharedAnnotation& annotation)
+void VoidRenderer::Render(const SharedPixels& data, const SharedAnnotation& annotation, const std::vector<ImageOp*>& operators)
 {
     /* Update the image data */
     m_ImageA = data;
@@ -420,7 +473,8 @@ void VoidRenderer::Render(const SharedPixels& data, const SharedAnnotation& anno
     SetAnnotation(annotation);
 
     /* Load the Textures to be rendered */
-    m_ImageRenderer.SetImage(m_ImageA);
+    LoadImage(m_ImageA);
+    m_ImageRenderer.SetOperators(operators);
 
     /* Trigger a Re-paint */
     update();
@@ -451,17 +505,22 @@ void VoidRenderer::Compare(SharedPixels first, SharedPixels second, ComparisonMo
     if (m_ImageA)
         m_RenderStatus->SetRenderResolution(m_ImageA->Width(), m_ImageA->Height());
 
-    /* Load the Textures to be rendered */
+    /* Load the Textures to be rendered, the textures are only accessible with the context current */
+    makeCurrent();
     m_ImageComparisonRenderer.SetImageA(m_ImageA);
     m_ImageComparisonRenderer.SetImageB(m_ImageB);
+    doneCurrent();
 
     /* Trigger a Re-paint */
     update();
 }
 
-void VoidRenderer::RenderGrid(const std::vector<SharedPixels>& grid)
+void VoidRenderer::RenderGrid(const std::vector<SharedPixels>& grid, const std::vector<TextureTransform>& transforms)
 {
-    m_GridRenderer.SetImages(grid);
+    /* Changed cells are uploaded onto the texture array, which is only accessible with the context current */
+    makeCurrent();
+    m_GridRenderer.SetImages(grid, transforms);
+    doneCurrent();
 
     // Hide the Error Label
     SetMessage("");
@@ -487,6 +546,7 @@ void VoidRenderer::Clear()
     /* Reset Buffers */
     m_ImageRenderer.Reset();
     m_ImageComparisonRenderer.Reset();
+    m_Uploader.Clear();
 
     /*
      * Trigger a Re-paint
@@ -610,9 +670,12 @@ void VoidRenderer::SetColorDisplay(const std::string& display)
 {
     ColorProcessor::Instance().Set(display);
 
+    /* The shaders are recompiled with the display transform, which needs the context current */
+    makeCurrent();
     m_ImageRenderer.ReinitShaderProgram();
     m_ImageComparisonRenderer.ReinitShaderProgram();
     m_GridRenderer.ReinitShaderProgram();
+    doneCurrent();
 
     update();
 }
@@ -678,6 +741,92 @@ void VoidRenderer::ReloadTextures()
     }
 }
 
+void VoidRenderer::LoadImage(const SharedPixels& image)
+{
+    if (!image)
+        return;
+
+    /* The textures are only accessible with the context current */
+    makeCurrent();
+
+    if (unsigned int texture = m_Uploader.Texture(image))
+        m_ImageRenderer.SetTexture(image, texture);
+    else
+    {
+        /**
+         * Uploaded as it is for now, the GPU scales it down when drawing, reducing it here would hold up the GUI thread
+         * the uploader has it at the reduced size in a bit and the texture is swapped once that is ready
+         */
+        m_ImageRenderer.SetImage(image);
+
+        if (m_DisplayFactor > 1)
+            m_Uploader.Request(image);
+    }
+
+    doneCurrent();
+}
+
+int VoidRenderer::DisplayFactor() const
+{
+    if (!m_ImageA || m_ImageA->Empty() || !width() || !height())
+        return 1;
+
+    /* Same scale as the image gets drawn with, see CalculateModelViewProjection */
+    float viewAspect = (width() * WidthDivisor()) / (height() * HeightDivisor());
+    float imageAspect = float(m_ImageA->Width()) / float((m_ImageA->Height() ? m_ImageA->Height() : 1));
+    float scale = (imageAspect > viewAspect) ? 1.f : imageAspect / viewAspect;
+
+    /* Width of the image on screen in device pixels */
+    float displayed = width() * devicePixelRatio() * scale * m_ZoomFactor;
+    float ratio = m_ImageA->Width() / displayed;
+
+    int factor = 1;
+    while (factor < MAX_DISPLAY_FACTOR && factor * 2 <= ratio)
+        factor *= 2;
+
+    return factor;
+}
+
+void VoidRenderer::UpdateDisplayFactor()
+{
+    int factor = DisplayFactor();
+    if (factor == m_DisplayFactor)
+        return;
+
+    m_DisplayFactor = factor;
+    m_Uploader.SetFactor(factor);
+
+    /**
+     * The current texture keeps being drawn while the uploader has the image at the factor for the zoom,
+     * the texture is swapped once that is ready, the upcoming ones get uploaded as they're preloaded
+     */
+    m_Uploader.Request(m_ImageA);
+}
+
+void VoidRenderer::FetchPixelProbe()
+{
+    float pixels[4] = { 0.f }; /* R G B A*/
+
+    /* Update the Pixel values on the Renderer Status bar */
+    if (m_PixelProbe.Fetch(pixels))
+        m_RenderStatus->SetColourValues(pixels[0], pixels[1], pixels[2], pixels[3]);
+
+    /* Nothing might get drawn for a while (e.g. when paused), check on the reads again a little later */
+    if (m_PixelProbe.Pending() && !m_ProbeScheduled)
+    {
+        m_ProbeScheduled = true;
+
+        QTimer::singleShot(PROBE_INTERVAL, this, [this]() -> void
+        {
+            m_ProbeScheduled = false;
+
+            makeCurrent();
+            FetchPixelProbe();
+            doneCurrent();
+        });
+    }
+}
+
 void VoidRenderer::ToggleAnnotation(bool t)
 {
     /* Update Annotation State */
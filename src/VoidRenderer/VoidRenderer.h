@@ -14,7 +14,10 @@
 
 /* Internal */
 #include "PixReader.h"
+#include "Core/PixelProbe.h"
 #include "Core/RenderTypes.h"
+#include "Core/TexturePool.h"
+#include "Core/TextureUploader.h"
 #include "RendererStatus.h"
 #include "Layers/ImageRenderLayer.h"
 #include "Layers/ImageComparisonRenderLayer.h"
@@ -43,15 +46,35 @@ public:
 
     /* Render the Image */
     void Render(SharedPixels data);
-    /* Render Image along with Annotations */
-    void Render(const SharedPixels& data, const SharedAnnotation& annotation);
+    /* Render Image along with Annotations, operators (with shaders) get applied on the image while drawing */
+    void Render(const SharedPixels& data, const SharedAnnotation& annotation, const std::vector<ImageOp*>& operators = {});
     /* Compare 2 Images */
     void Compare(SharedPixels first, SharedPixels second, ComparisonMode comparison, BlendMode blend);
-    /* Render Media in a Grid Representation (Layout/Contact Sheet) */
-    void RenderGrid(const std::vector<SharedPixels>& grid);
+    /* Render Media in a Grid Representation (Layout/Contact Sheet), along with the geometric transforms of each */
+    void RenderGrid(const std::vector<SharedPixels>& grid, const std::vector<TextureTransform>& transforms = {});
     /* Clears current Frame and rids of any textures that were loaded */
     void Clear();
 
+    /**
+     * @brief Uploads the images around the one being rendered, these are kept resident on the GPU
+     * and rendering any of these later only binds the texture it has been uploaded onto.
+     *
+     * @param ahead Images which are going to be rendered, in the order they are going to be rendered.
+     * @param behind Images which have been rendered, most recent first.
+     */
+    inline void Preload(const std::vector<SharedPixels>& ahead, const std::vector<SharedPixels>& behind = {})
+    {
+        m_Uploader.Preload(ahead, behind);
+    }
+
+    /* Number of images on either side of the one being rendered which can be preloaded */
+    inline std::size_t PreloadWindow() const { return m_Uploader.Active() ? m_Uploader.Window() : 0; }
+
+    /**
+     * @brief Sets the memory (in MB) the textures kept resident on the GPU can take.
+     */
+    inline void SetTextureMemory(std::size_t megabytes) { m_Uploader.SetBudget(megabytes * 1024 * 1024); }
+
     Renderer::RenderData<unsigned char> FrameBuffer();
 
     /* Set zoom values */
@@ -144,6 +167,9 @@ private: /* Members */
     SharedPixels m_ImageA;
     SharedPixels m_ImageB;
 
+    /* Textures and staging buffers shared by the image render layers */
+    TexturePool m_TexturePool;
+
     /**
      * Render Layers
      * Renders Textures and other elements on the Viewer
@@ -159,8 +185,16 @@ private: /* Members */
     TextAnnotationsRenderLayer m_TextRenderer;
     GridRenderLayer m_GridRenderer;
 
+    /* Uploads images onto textures ahead of them being rendered and keeps them resident */
+    TextureUploader m_Uploader;
+
     SharedAnnotation m_Annotation;
 
+    /* Reads back the color of the pixel under the mouse without stalling the drawing */
+    PixelProbe m_PixelProbe;
+    /* Whether checking on the pending pixel reads has been scheduled */
+    bool m_ProbeScheduled;
+
     /**
      * ModelViewProjection matrix for the Texture
      */
@@ -184,6 +218,9 @@ private: /* Members */
     float m_ZoomFactor;
     float m_TranslateX, m_TranslateY;
 
+    /* Factor the images are downscaled by (on the upload thread) before being uploaded */
+    int m_DisplayFactor;
+
     bool m_Pressed;
     bool m_Annotating;
     bool m_Fullscreen;
@@ -247,6 +284,30 @@ private: /* Methods */
      */
     void ReloadTextures();
 
+    /**
+     * @brief Sets the image on the image render layer, binding the texture it has been uploaded onto
+     * if it was uploaded ahead, else uploading it now as it is and requesting the uploader for the reduced size.
+     */
+    void LoadImage(const SharedPixels& image);
+
+    /**
+     * @brief Returns the factor (power of 2) the image can be downscaled by without losing any detail on screen
+     * at the current zoom, i.e. how many pixels of the image end up on one pixel of the viewport.
+     */
+    int DisplayFactor() const;
+
+    /**
+     * @brief Has the displayed image uploaded again (along with the upcoming ones) at the reduced size for the
+     * current zoom if that has changed since, nothing is uploaded here. Called with the context current.
+     */
+    void UpdateDisplayFactor();
+
+    /**
+     * @brief Shows the color of the most recently probed pixel once the GPU has read it back, and schedules
+     * checking again if there are reads still pending. Called with the context current.
+     */
+    void FetchPixelProbe();
+
     /**
      * @brief (Re)Sets the Mouse pointer based on the current Annotation tool
      * 
@@ -1,9 +1,14 @@
 // Copyright (c) 2025 waaake
 // Licensed under the MIT License
 
+/* STD */
+#include <algorithm>
+#include <memory>
+
 /* Internal */
 #include "Exporter.h"
 #include "VoidCore/ColorProcessor.h"
+#include "VoidObjects/Effects/Effects.h"
 #include "VoidUi/Player/Player.h"
 #include "VoidCore/Media/Renderer.h"
 
@@ -11,89 +16,144 @@ VOID_NAMESPACE_OPEN
 
 ExportAnnotatedFramesTask::ExportAnnotatedFramesTask(const MediaExportDescriptor& descriptor, Player* player)
     : Task("Export Annotated Frames")
-    , m_Player(player)
     , m_Descriptor(descriptor)
 {
+    const SharedMediaClip media = player->m_ActiveViewBuffer->GetMediaClip();
+    m_Media = media;
+
+    // Nothing is being viewed, the task reports that when it runs
+    if (!media)
+        return;
+
+    // The annotations could be edited while the export runs, these are small enough to be copied upfront
+    for (const auto& [frame, annotation] : media->Annotations())
+    {
+        if (!annotation || !media->Contains(frame))
+            continue;
+
+        Renderer::SharedAnnotation copy = std::make_shared<Renderer::Annotation>(*annotation);
+        // Text still being typed isn't a part of the annotation yet
+        copy->draft.active = false;
+
+        m_Frames.emplace_back(frame, std::move(copy));
+    }
+
+    std::sort(m_Frames.begin(), m_Frames.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    // Same split as the viewer, the chain gets evaluated on the frame and the rest of the effects are drawn
+    m_Chain = media->Chain();
+
+    for (Effect* effect : media->Effects())
+    {
+        if (effect->Enabled() && (m_Chain->Empty() || effect->ImageOperator()->Geometric()))
+        {
+            // The operators are held on to and their values taken here, the effects could be edited or removed meanwhile
+            m_Operators.push_back(effect->Operator());
+            m_Params.push_back(effect->ImageOperator()->Snapshot());
+        }
+    }
 }
 
 bool ExportAnnotatedFramesTask::Work()
 {
-    const auto& annotations = m_Player->m_ActiveViewBuffer->Annotations();
-    if (annotations.empty())
+    SharedMediaClip media = m_Media.lock();
+
+    if (!media)
+    {
+        Log("Unable to access media.", TaskLog::Level::ErrorLog);
         return false;
+    }
 
-    SetMax(static_cast<int>(annotations.size()));
+    if (m_Frames.empty())
+    {
+        Log("No annotated frames found for current media.", TaskLog::Level::ErrorLog);
+        return false;
+    }
 
-    int count = 1;
+    if (m_Descriptor.type != WriterType::Movie && !(m_Descriptor.type == WriterType::Image && m_Descriptor.entry.Templated()))
+    {
+        Log(
+            QString("Provided filepath to render is not templated (i.e. filename.####.ext). %1")
+                .arg(m_Descriptor.entry.Fullpath().c_str()),
+            TaskLog::Level::ErrorLog
+        );
+        return false;
+    }
 
+    SetMax(static_cast<int>(m_Frames.size()));
 
-    if (m_Descriptor.type == WriterType::Image && m_Descriptor.entry.Templated())
-    {
-        const Renderer::RenderData r = m_Player->m_Renderer->FrameBuffer();
-        Renderer::ImageRenderer ir(m_Descriptor.entry, {r.width, r.height, r.channels, r.type});
+    // Writers are created for the size of the first rendered frame
+    std::unique_ptr<Renderer::ImageRenderer> ir;
+    std::unique_ptr<Renderer::MovieRenderer> mr;
 
-        for (auto& [frame, _] : annotations)
-        {
-            if (auto data = m_Player->m_ActiveViewBuffer->MData(frame))
-            {
-                m_Player->m_Renderer->Render(data.image, data.annotation);
-                const Renderer::RenderData r = m_Player->m_Renderer->FrameBuffer();
+    std::vector<ImageOp*> operators;
+    operators.reserve(m_Operators.size());
 
-                if (!ir.Render(frame, r.pixels.data(), r.Size(), {r.width, r.height, r.channels, r.type}))
-                {
-                    // ErrorMessageBox box("There was an error in exporting media.", "Error", this);
-                    // box.exec();
-                    return false;
-                }
+    for (const SharedImageOp& op : m_Operators)
+        operators.push_back(op.get());
 
-                SetProgress(count);
-                count++;
-            }
+    int count = 0;
+    bool success = true;
+
+    for (auto& [frame, annotation] : m_Frames)
+    {
+        if (Cancelled())
+        {
+            success = false;
+            break;
         }
 
-        // Render back the current frame
-        // This is obviously temporary till we have an offscreen renderer available for using offscreen framebuffer
-        m_Player->Refresh();
+        // Each frame is read (or copied if cached) and evaluated here, only the one being rendered is held in memory
+        SharedPixels image = media->EvaluateCopy(frame, *m_Chain);
 
-        // InfoMessageBox box("Annotated frames have been exported.", "Success", this);
-        // box.exec();
-        return true;
-    }
-    else if (m_Descriptor.type == WriterType::Movie)
-    {
-        const Renderer::RenderData r = m_Player->m_Renderer->FrameBuffer();
-        Renderer::MovieRenderer mr(m_Descriptor.entry, {r.width, r.height, r.channels, r.type});
+        // Rendered offscreen, the viewer keeps displaying whatever it was
+        const Renderer::RenderData r = m_Renderer.Render(image, annotation, operators, m_Params);
 
-        for (auto& [frame, _] : annotations)
+        // Done with the copy of the frame
+        image = nullptr;
+        if (r.pixels.empty())
         {
-            if (auto data = m_Player->m_ActiveViewBuffer->MData(frame))
-            {
-                m_Player->m_Renderer->Render(data.image, data.annotation);
-                const Renderer::RenderData r = m_Player->m_Renderer->FrameBuffer();
-                if (!mr.AddBuffer(r.pixels.data(), r.Size(), {r.width, r.height, r.channels, r.type}))
-                {
-                    // ErrorMessageBox box("There was an error in exporting media.", "Error", this);
-                    // box.exec();
-                    return false;
-                }
+            Log(QString("Unable to render annotated frame: %1").arg(frame), TaskLog::Level::ErrorLog);
+            success = false;
+            break;
+        }
 
-                SetProgress(count);
-                count++;
-            }
+        if (m_Descriptor.type == WriterType::Image)
+        {
+            if (!ir)
+                ir = std::make_unique<Renderer::ImageRenderer>(m_Descriptor.entry, EncodeSpec{r.width, r.height, r.channels, r.type});
+
+            success = ir->Render(frame, r.pixels.data(), r.Size(), {r.width, r.height, r.channels, r.type});
         }
+        else
+        {
+            if (!mr)
+                mr = std::make_unique<Renderer::MovieRenderer>(m_Descriptor.entry, EncodeSpec{r.width, r.height, r.channels, r.type});
 
-        mr.Render();
+            success = mr->AddBuffer(r.pixels.data(), r.Size(), {r.width, r.height, r.channels, r.type});
+        }
 
-        // Render back the current frame
-        // This is obviously temporary till we have an offscreen renderer available for using offscreen framebuffer
-        m_Player->Refresh();
+        if (!success)
+        {
+            Log(QString("Unable to export annotated frame: %1").arg(frame), TaskLog::Level::ErrorLog);
+            break;
+        }
 
-        // InfoMessageBox box("Annotated frames have been exported.", "Success", this);
-        // box.exec();
-        return true;
+        count++;
+        SetProgress(count);
     }
 
-    return false;
+    // The context belongs to this thread, everything it holds is released from here
+    m_Renderer.Release();
+
+    if (!success)
+        return false;
+
+    if (mr)
+        mr->Render();
+
+    Log("Annotated frames have been exported.", TaskLog::Level::InfoLog);
+    return true;
 }
 
 /// ExportMediaFramesTask
@@ -101,6 +161,7 @@ bool ExportAnnotatedFramesTask::Work()
 ExportMediaFramesTask::ExportMediaFramesTask(const SharedMediaClip& media, const MediaExportDescriptor& descriptor, const EncodeSpec& spec, const MFrameRange& range, const std::string& colorspace)
     : Task("Transcode Media")
     , m_Media(media)
+    , m_Chain(media->FullChain())
     , m_Descriptor(descriptor)
     , m_Spec(spec)
     , m_Range(range)
@@ -152,10 +213,11 @@ bool ExportMediaFramesTask::Work()
                     continue;
                 }
 
-                SharedPixels image = media->Image(i);
+                // The full chain of effects is evaluated on a copy, leaving the frame as the viewer has it
+                SharedPixels image = media->EvaluateCopy(i, *m_Chain);
 
                 /// Colorspace processor
-                ColorProcessor::Instance().ProcessImage(static_cast<float*>(image->Writable()), image->Width(), image->Height(), image->Channels(), m_Colorspace);
+                ColorProcessor::Instance().ProcessImage(static_cast<float*>(image->Writable()), image->Width(), image->Height(), image->Channels(), m_Colorspace, ColorProcessor::Optimization::Export);
                 if (!ir.Render(i, image->Pixels(), image->FrameSize(), {image->Width(), image->Height(), image->Channels(), BufferType::Float}))
                 {
                     Log(QString("Unable to render current frame: %1").arg(i), TaskLog::Level::ErrorLog);
@@ -201,10 +263,11 @@ bool ExportMediaFramesTask::Work()
                     continue;
                 }
 
-                SharedPixels image = media->Image(i);
+                // The full chain of effects is evaluated on a copy, leaving the frame as the viewer has it
+                SharedPixels image = media->EvaluateCopy(i, *m_Chain);
 
                 /// Colorspace processor
-                ColorProcessor::Instance().ProcessImage(static_cast<float*>(image->Writable()), image->Width(), image->Height(), image->Channels(), m_Colorspace);
+                ColorProcessor::Instance().ProcessImage(static_cast<float*>(image->Writable()), image->Width(), image->Height(), image->Channels(), m_Colorspace, ColorProcessor::Optimization::Export);
                 if (!mr.AddBuffer(image->Pixels(), image->FrameSize(), {image->Width(), image->Height(), image->Channels(), BufferType::Float}))
                 {
                     Log(QString("Unable to buffer current frame: %1").arg(i), TaskLog::Level::ErrorLog);
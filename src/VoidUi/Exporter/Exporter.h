@@ -11,24 +11,45 @@
 #include "Definition.h"
 #include "VoidObjects/Core/Task.h"
 #include "VoidObjects/Media/MediaClip.h"
+#include "VoidRenderer/OffscreenRenderer.h"
 #include "VoidUi/Media/Browser.h"
+#include "VoidUi/Player/ViewerBuffer.h"
 
 VOID_NAMESPACE_OPEN
 
 // Forward decl
 class Player;
 
+/**
+ * Renders the annotated frames of the active media (along with the annotations) and exports them
+ * The frames are rendered offscreen at the resolution of the media, so the viewer isn't affected while exporting
+ */
 class ExportAnnotatedFramesTask : public Task
 {
 public:
+    /**
+     * Needs to be created on the GUI thread, that's where the offscreen surface gets created
+     * and where the annotations and the effects of the active media are taken from
+     */
     ExportAnnotatedFramesTask(const MediaExportDescriptor& descriptor, Player* player);
+    inline std::string Label() const override { return m_Descriptor.entry.TemplatedName(); }
 
 protected:
     bool Work() override;
 
 private:
-    Player* m_Player;
     MediaExportDescriptor m_Descriptor;
+    std::weak_ptr<MediaClip> m_Media;
+
+    /* Annotated frames in order, with a copy of their annotation, the frames themselves are read one at a time */
+    std::vector<std::pair<v_frame_t, Renderer::SharedAnnotation>> m_Frames;
+
+    /* Effects evaluated on the frames and the ones drawn with them, the same as the viewer has them when exporting */
+    SharedEffectChain m_Chain;
+    std::vector<SharedImageOp> m_Operators;
+    std::vector<ParamSnapshot> m_Params;
+
+    OffscreenRenderer m_Renderer;
 };
 
 class ExportMediaFramesTask : public Task
@@ -42,6 +63,8 @@ protected:
 
 private: /* Members */
     std::weak_ptr<MediaClip> m_Media;
+    /* Effects as they are when the export is queued, editing them meanwhile doesn't change what gets exported */
+    SharedEffectChain m_Chain;
     MediaExportDescriptor m_Descriptor;
     EncodeSpec m_Spec;
     MFrameRange m_Range;
@@ -1,12 +1,17 @@
 // Copyright (c) 2025 waaake
 // Licensed under the MIT License
 
+/* STD */
+#include <algorithm>
+
 /* Qt */
 #include <QDragMoveEvent>
 #include <QMimeData>
 
 /* Internal */
 #include "Player.h"
+#include "VoidCore/Logging.h"
+#include "VoidCore/SystemMemory.h"
 #include "VoidCore/Timekeeper.h"
 #include "VoidCore/Media/Renderer.h"
 #include "VoidUi/Descriptors.h"
@@ -15,16 +20,22 @@
 #include "VoidUi/Engine/Globals.h"
 #include "VoidUi/Exporter/Exporter.h"
 #include "VoidUi/Exporter/MediaExporter.h"
+#include "VoidUi/Preferences/Preferences.h"
 #include "VoidUi/QExtensions/MessageBox.h"
 
 VOID_NAMESPACE_OPEN
 
 Player::Player(QWidget* parent)
     : PlayerWidget(parent)
+    , m_AutoMemory(false)
+    , m_Budget(0)
+    , m_UnderPressure(false)
 {
     m_ViewBufferA.SetActivePlayer(this);
     m_ViewBufferB.SetActivePlayer(this);
     Connect();
+
+    SetAutoMemory(VoidPreferences::Instance().GetCacheAutoMemory());
 }
 
 Player::~Player()
@@ -106,6 +117,9 @@ void Player::SetMedia(const SharedMediaClip& media, const PlayerViewBuffer& buff
     active->SetActive(true);
     inactive->SetActive(false);
 
+    if (m_AutoMemory)
+        UpdateBudget();
+
     SetRange(m_ActiveViewBuffer->StartFrame(), m_ActiveViewBuffer->EndFrame());
     Render(m_Timeline->Frame());
 
@@ -281,6 +295,13 @@ void Player::Connect()
     connect(&m_ViewBufferB, &ViewerBuffer::playlistUpdated, this, &Player::playlistUpdated);
     connect(&m_ViewBufferA, &ViewerBuffer::updated, this, &Player::Refresh);
     connect(&m_ViewBufferB, &ViewerBuffer::updated, this, &Player::Refresh);
+
+    // Cache Memory
+    connect(&m_BudgetTimer, &QTimer::timeout, this, &Player::UpdateBudget);
+    connect(&VoidPreferences::Instance(), &VoidPreferences::updated, this, [this]()
+    {
+        SetAutoMemory(VoidPreferences::Instance().GetCacheAutoMemory());
+    });
 }
 
 void Player::PauseCache()
@@ -322,7 +343,13 @@ void Player::Render(int frame)
     BufferData data = m_ActiveViewBuffer->MData(frame);
 
     if (data)
-        m_Renderer->Render(data.image, data.annotation);
+    {
+        m_Renderer->Render(data.image, data.annotation, data.operators);
+
+        /* Get the frames around this one resident on the GPU while this one is displayed */
+        if (std::size_t count = m_Renderer->PreloadWindow())
+            m_Renderer->Preload(m_ActiveViewBuffer->Upcoming(frame, count), m_ActiveViewBuffer->Upcoming(frame, count, true));
+    }
 }
 
 // void Player::SetSequenceFrame(int frame)
@@ -492,7 +519,10 @@ void Player::CompareMediaFrame(v_frame_t frame)
 
 void Player::RenderGrid(v_frame_t frame)
 {
-    m_Renderer->RenderGrid(m_ActiveViewBuffer->GridFrame(frame));
+    std::vector<TextureTransform> transforms;
+    std::vector<SharedPixels> grid = m_ActiveViewBuffer->GridFrame(frame, transforms);
+
+    m_Renderer->RenderGrid(grid, transforms);
 }
 
 void Player::SetComparisonMode(int mode)
@@ -514,6 +544,10 @@ void Player::SetComparisonMode(int mode)
         m_ControlBar->SetViewerControl(ViewerControl::None);
     }
 
+    /* Both the buffers are being played now (or just the one), the budget is split accordingly */
+    if (m_AutoMemory)
+        UpdateBudget();
+
     Refresh();
 }
 
@@ -547,63 +581,10 @@ void Player::RenderAnnotatedFrames()
     if (browser.Save())
     {
         const MediaExportDescriptor descriptor = browser.File();
-        if (descriptor.type == WriterType::Image && descriptor.entry.Templated())
-        {
-            const Renderer::RenderData r = m_Renderer->FrameBuffer();
-            Renderer::ImageRenderer ir(descriptor.entry, {r.width, r.height, r.channels, r.type});
-
-            for (auto& [frame, _] : annotations)
-            {
-                if (auto data = m_ActiveViewBuffer->MData(frame))
-                {
-                    m_Renderer->Render(data.image, data.annotation);
-                    const Renderer::RenderData r = m_Renderer->FrameBuffer();
-                    if (!ir.Render(frame, r.pixels.data(), r.Size(), {r.width, r.height, r.channels, r.type}))
-                    {
-                        ErrorMessageBox box("There was an error in exporting media.", "Error", this);
-                        box.exec();
-                        return;
-                    }
-                }
-            }
-
-            // Render back the current frame
-            // This is obviously temporary till we have an offscreen renderer available for using offscreen framebuffer
-            Refresh();
-
-            InfoMessageBox box("Annotated frames have been exported.", "Success", this);
-            box.exec();
-            return;
-        }
-        else if (descriptor.type == WriterType::Movie)
+        if ((descriptor.type == WriterType::Image && descriptor.entry.Templated()) || descriptor.type == WriterType::Movie)
         {
-            const Renderer::RenderData r = m_Renderer->FrameBuffer();
-            Renderer::MovieRenderer mr(descriptor.entry, {r.width, r.height, r.channels, r.type});
-
-            for (auto& [frame, _] : annotations)
-            {
-                if (auto data = m_ActiveViewBuffer->MData(frame))
-                {
-                    m_Renderer->Render(data.image, data.annotation);
-                    const Renderer::RenderData r = m_Renderer->FrameBuffer();
-                    if (!mr.AddBuffer(r.pixels.data(), r.Size(), {r.width, r.height, r.channels, r.type}))
-                    {
-                        ErrorMessageBox box("There was an error in exporting media.", "Error", this);
-                        box.exec();
-                        return;
-                    }
-                }
-            }
-
-            mr.Render();
-
-            // Render back the current frame
-            // This is obviously temporary till we have an offscreen renderer available for using offscreen framebuffer
-            Refresh();
-
-            InfoMessageBox box("Annotated frames have been exported.", "Success", this);
-            box.exec();
-            return;
+            /* Frames are rendered offscreen in the background, the viewer stays on the current frame */
+            UIGlobals::QueueTask(new ExportAnnotatedFramesTask(descriptor, this));
         }
     }
 }
@@ -750,4 +731,85 @@ void Player::dropEvent(QDropEvent* event)
     m_Overlay->setVisible(false);
 }
 
+void Player::SetAutoMemory(bool automatic)
+{
+    /* The preferences are updated as a whole, the budget isn't reset when the setting didn't change */
+    if (automatic == m_AutoMemory)
+        return;
+
+    m_AutoMemory = automatic;
+
+    if (m_AutoMemory)
+    {
+        m_Budget = 0;
+        m_UnderPressure = false;
+
+        m_BudgetTimer.start(1000);
+        UpdateBudget();
+    }
+    else
+        m_BudgetTimer.stop();
+}
+
+void Player::UpdateBudget()
+{
+    const MemoryState state = SystemMemory::Query();
+
+    /* Not supported on the platform, the max memory stays as it was */
+    if (!state.Valid())
+        return;
+
+    /* Both the buffers are accounted for, what they hold is memory they can keep */
+    const std::size_t used = m_ViewBufferA.UsedMemory() + m_ViewBufferB.UsedMemory();
+
+    /* Headroom for the rest of the application and the system, 10% of the memory but atleast 512 MB */
+    const std::size_t headroom = std::max<std::size_t>(state.total / 10, 512ULL * 1024 * 1024);
+    std::size_t budget = used + state.available > headroom ? used + state.available - headroom : 0;
+
+    /**
+     * Tasks are already being stalled on memory, let go of a quarter of the cache as the pressure begins
+     * instead of waiting for the available memory to run out, the reduced budget is then held (not cut again)
+     * till the pressure eases below half of the mark it started at
+     */
+    if (!m_UnderPressure && state.pressure >= 10.0)
+    {
+        m_UnderPressure = true;
+
+        const std::size_t previous = m_Budget ? m_Budget : used;
+        budget = std::min(budget, previous - previous / 4);
+
+        VOID_LOG_INFO("Memory Pressure: {0}, Cache Memory Reduced: {1} MB", state.pressure, budget / (1024 * 1024));
+    }
+    else if (m_UnderPressure)
+    {
+        if (state.pressure < 5.0)
+            m_UnderPressure = false;
+        else
+            budget = std::min(budget, m_Budget);
+    }
+
+    /* Minimum for each of the buffers, atleast a few frames are always allowed to be cached */
+    constexpr std::size_t minimum = 256ULL * 1024 * 1024;
+    m_Budget = std::max<std::size_t>(budget, 2 * minimum);
+
+    if (Comparing())
+    {
+        /* Both the buffers are played together */
+        m_ViewBufferA.SetMemoryBudget(m_Budget / 2);
+        m_ViewBufferB.SetMemoryBudget(m_Budget / 2);
+    }
+    else
+    {
+        /**
+         * The buffer not being played keeps what it has cached within a quarter of the budget
+         * (atleast the minimum), the buffer being played gets the rest
+         */
+        ViewerBuffer* inactive = m_ActiveViewBuffer == &m_ViewBufferA ? &m_ViewBufferB : &m_ViewBufferA;
+        const std::size_t share = std::max(std::min(inactive->UsedMemory(), m_Budget / 4), minimum);
+
+        inactive->SetMemoryBudget(share);
+        m_ActiveViewBuffer->SetMemoryBudget(m_Budget - share);
+    }
+}
+
 VOID_NAMESPACE_CLOSE
@@ -4,6 +4,9 @@
 #ifndef _VOID_PLAYER_H
 #define _VOID_PLAYER_H
 
+/* Qt */
+#include <QTimer>
+
 /* Internal */
 #include "PlayerWidget.h"
 #include "VoidAudio/Core/Decoder.h"
@@ -32,6 +35,8 @@ public:
 
     inline void Refresh() { SetFrame(m_Timeline->Frame()); }
     inline ViewerBuffer* ActiveViewer() const { return m_ActiveViewBuffer; }
+    /* Returns the viewer buffer other than the provided one, i.e. B for A and A for B */
+    inline const ViewerBuffer* OtherViewer(const ViewerBuffer* buffer) const { return buffer == &m_ViewBufferA ? &m_ViewBufferB : &m_ViewBufferA; }
 
     void SetMedia(const SharedMediaClip& media);
     void SetMedia(const std::vector<SharedMediaClip>& media);
@@ -88,6 +93,18 @@ protected:
 private: /* Members */
     AudioDecoder m_AudioDecoder;
 
+    /**
+     * With automatic memory, one budget is periodically computed from the state of the system memory
+     * for both the viewer buffers and split between them, it grows when memory is free and shrinks
+     * (evicting frames) when the memory comes under pressure
+     */
+    bool m_AutoMemory;
+    QTimer m_BudgetTimer;
+    std::size_t m_Budget;
+
+    /* Whether the memory is under pressure, the budget is cut once as the pressure begins and held till it eases */
+    bool m_UnderPressure;
+
 private: /* Methods */
     void Render(int frame);
     // void SetMediaFrame(int frame);
@@ -99,6 +116,18 @@ private: /* Methods */
 
     void ResetViewBuffer(const PlayerViewBuffer& buffer);
 
+    /**
+     * Sets whether the cache memory is managed automatically based on the memory available on the system
+     * (or the cgroup the application runs in), the memory set in the preferences is ignored while this is enabled
+     */
+    void SetAutoMemory(bool automatic);
+
+    /**
+     * Computes the memory budget from the current state of the system memory and splits it between the
+     * viewer buffers, the active buffer gets most of it unless both are being compared
+     */
+    void UpdateBudget();
+
     void Connect();
 
     void PreviousMedia();
@@ -104,6 +104,10 @@ void PlayerWidget::Connect()
 
 void PlayerWidget::RemoveMedia(const SharedMediaClip& media)
 {
+    /* The media could still be held in memory by any of the buffers */
+    m_ViewBufferA.RemoveResident(media);
+    m_ViewBufferB.RemoveResident(media);
+
     // Check if the media was playing currently
     if (m_ActiveViewBuffer->Playing(media))
     {
@@ -117,6 +121,7 @@ void PlayerWidget::SetFromPreferences()
     VOID_LOG_INFO("Player Preferences Updated.");
     /* Reset the Missing Frame Hanlder */
     SetMissingFrameHandler(VoidPreferences::Instance().GetMissingFrameHandler());
+    m_Renderer->SetTextureMemory(VoidPreferences::Instance().GetCacheTextureMemory());
 }
 
 void PlayerWidget::Build()
@@ -138,6 +143,7 @@ void PlayerWidget::Build()
     /* Instantiate widgets */
     m_ControlBar = new ControlBar(&m_ViewBufferA, &m_ViewBufferB, this);
     m_Renderer = new VoidRenderer(this);
+    m_Renderer->SetTextureMemory(VoidPreferences::Instance().GetCacheTextureMemory());
     /* The placeholder renderer for when the actual renderer is fullscreen */
     m_PlaceholderRenderer = new VoidPlaceholderRenderer(this);
     /* Is hidden by default */
@@ -1,6 +1,9 @@
 // Copyright (c) 2025 waaake
 // Licensed under the MIT License
 
+/* STD */
+#include <algorithm>
+
 /* Internal */
 #include "ViewerBuffer.h"
 #include "VoidCore/Logging.h"
@@ -34,6 +37,11 @@ ViewerBuffer::ViewerBuffer(QObject* parent)
     , m_MaxMemory(VoidPreferences::Instance().GetCacheMemory() * 1024 * 1024 * 1024) // 1 GB by default
     , m_UsedMemory(0)
     , m_FrameSize(0)
+    , m_ResidentMemory(0)
+    , m_Preloaded(nullptr)
+    , m_PreloadWindow(2.0)
+    , m_Prefetched(nullptr)
+    , m_Chain(nullptr)
     , m_Startframe(0)
     , m_Endframe(1)
     , m_LastCached(0)
@@ -52,13 +60,14 @@ ViewerBuffer::~ViewerBuffer()
 
 void ViewerBuffer::Set(const SharedMediaClip& media)
 {
-    Refresh();
+    Release();
 
     m_Clip = media;
     m_Clip->SetColor(m_Color);
 
     m_PlayingComponent = PlayableComponent::Clip;
     UpdateRange(m_Clip->FirstFrame(), m_Clip->LastFrame());
+    Restore();
     EnsureCached(media->FirstFrame());
 
     emit playlistUpdated(nullptr);
@@ -67,7 +76,7 @@ void ViewerBuffer::Set(const SharedMediaClip& media)
 
 void ViewerBuffer::Set(const SharedPlaybackTrack& track)
 {
-    Refresh();
+    Release();
 
     m_Track = track;
     m_Track->SetColor(m_Color);
@@ -83,7 +92,7 @@ void ViewerBuffer::Set(const SharedPlaybackTrack& track)
 
 void ViewerBuffer::Set(const SharedPlaybackSequence& sequence)
 {
-    Refresh();
+    Release();
 
     m_Sequence = sequence;
     m_PlayingComponent = PlayableComponent::Sequence;
@@ -97,7 +106,7 @@ void ViewerBuffer::Set(const SharedPlaybackSequence& sequence)
 
 void ViewerBuffer::Set(const std::vector<SharedMediaClip>& media)
 {
-    Refresh();
+    Release();
 
     m_Track->Clear();
     for (const SharedMediaClip& media : media)
@@ -114,7 +123,7 @@ void ViewerBuffer::Set(const std::vector<SharedMediaClip>& media)
 
 void ViewerBuffer::SetGrid(Playlist* playlist)
 {
-    Refresh();
+    Release();
     if (m_Playlist)
         disconnect(m_Playlist, &Playlist::updated, this, &ViewerBuffer::updated);
 
@@ -134,7 +143,7 @@ void ViewerBuffer::SetGrid(Playlist* playlist)
 
 void ViewerBuffer::SetPlaylist(Playlist* playlist)
 {
-    Refresh();
+    Release();
     if (m_Playlist)
         disconnect(m_Playlist, &Playlist::updated, this, &ViewerBuffer::updated);
 
@@ -145,6 +154,7 @@ void ViewerBuffer::SetPlaylist(Playlist* playlist)
 
     m_PlayingComponent = PlayableComponent::Playlist;
     UpdateRange(m_Clip->FirstFrame(), m_Clip->LastFrame());
+    Restore();
 
     emit playlistUpdated(playlist);
 
@@ -201,15 +211,22 @@ void ViewerBuffer::Refresh()
 {
     /* Clear any cached item */
     m_CachedTrackItem = nullptr;
-    ClearCache();
+    ClearActive();
 }
 
 void ViewerBuffer::ClearCache()
+{
+    ClearActive();
+    ClearResident();
+}
+
+void ViewerBuffer::ClearActive()
 {
     StopCaching();
 
-    m_Framenumbers.clear();
-    m_Buffered.clear();
+    m_Framenumbers.Clear();
+    m_Requested.Clear();
+    m_Buffered.Clear();
     m_UsedMemory = 0;
 
     if (m_PlayingComponent == PlayableComponent::Track)
@@ -220,6 +237,312 @@ void ViewerBuffer::ClearCache()
         m_Clip->ClearCache();
 }
 
+void ViewerBuffer::Release()
+{
+    /* Clear any cached item */
+    m_CachedTrackItem = nullptr;
+    m_Prefetched = nullptr;
+
+    /**
+     * Only a clip (played on its own or from a playlist) is kept resident
+     * tracks and sequences are cleared as their items could be referring the same media at different ranges
+     */
+    bool clip = m_PlayingComponent == PlayableComponent::Clip || m_PlayingComponent == PlayableComponent::Playlist;
+
+    if (!clip || !m_Clip->Valid())
+    {
+        ClearActive();
+        m_Chain = nullptr;
+        return;
+    }
+
+    /* Whatever has been read till the caching is stopped is what stays in memory */
+    StopCaching();
+
+    /* Only the original frames are kept resident, these are evaluated again with the chain the clip has once it's back */
+    if (m_Chain && !m_Chain->Empty())
+    {
+        for (v_frame_t frame = m_Startframe; frame <= m_Endframe; ++frame)
+        {
+            if (Cached(frame))
+                m_Clip->ReleaseEvaluated(frame);
+        }
+    }
+
+    m_Chain = nullptr;
+
+    const std::size_t memory = m_Buffered.Count() * m_FrameSize;
+
+    /* Nothing was cached for the clip, nothing to hold on to */
+    if (memory)
+    {
+        m_Resident.push_front({m_Clip, memory});
+        m_ResidentMemory += memory;
+    }
+
+    m_Framenumbers.Clear();
+    m_Requested.Clear();
+    m_Buffered.Clear();
+    m_UsedMemory = 0;
+}
+
+bool ViewerBuffer::Restore()
+{
+    auto it = std::find_if(m_Resident.begin(), m_Resident.end(), [this](const ResidentClip& r) { return r.clip == m_Clip; });
+
+    if (it == m_Resident.end())
+        return false;
+
+    m_ResidentMemory -= it->memory;
+    m_Resident.erase(it);
+
+    /**
+     * Rebuild the index from the frames which are still in memory for the clip
+     * some of these could have been cleared since, if the same media was played as a part of a track
+     */
+    for (v_frame_t frame = m_Startframe; frame <= m_Endframe; ++frame)
+    {
+        if (m_Clip->Contains(frame) && m_Clip->Cached(frame))
+        {
+            m_Framenumbers.PushBack(frame);
+            m_Requested.Set(frame);
+            Store(frame);
+        }
+    }
+
+    m_FrameSize = m_Clip->FrameSize();
+    m_UsedMemory = m_Buffered.Count() * FrameCost();
+
+    VOID_LOG_INFO("Restored {0} Cached Frames for {1}", m_Buffered.Count(), m_Clip->Name());
+    return true;
+}
+
+bool ViewerBuffer::EvictResident()
+{
+    /**
+     * Clips are shared between the buffers and the items of tracks, clearing the cache of a clip which is still
+     * a part of what either buffer plays would take the frames from under the active component
+     */
+    const ViewerBuffer* other = m_Player ? m_Player->OtherViewer(this) : nullptr;
+
+    /* The clip played the longest ago */
+    for (auto it = m_Resident.rbegin(); it != m_Resident.rend(); ++it)
+    {
+        /* The clip being preloaded is the one to be played next, it is let go of only when clearing */
+        if (it->clip == m_Preloaded || References(it->clip) || (other && other->References(it->clip)))
+            continue;
+
+        it->clip->ClearCache();
+        m_ResidentMemory -= it->memory;
+        m_Resident.erase(std::next(it).base());
+
+        return true;
+    }
+
+    return false;
+}
+
+void ViewerBuffer::Preload()
+{
+    if (!PreloadPending() || !m_FrameSize || !m_Player)
+        return;
+
+    bool forwards = m_State == PlayState::Forwards;
+
+    if (!forwards && m_State != PlayState::Backwards)
+        return;
+
+    const double framerate = m_Clip->Framerate() > 0 ? m_Clip->Framerate() : 24.0;
+    const v_frame_t window = static_cast<v_frame_t>(framerate * m_PreloadWindow);
+
+    /* Not yet towards the end of the clip in the direction of playback */
+    if ((forwards ? m_Endframe - m_Player->Frame() : m_Player->Frame() - m_Startframe) > window)
+        return;
+
+    SharedMediaClip upcoming = forwards ? m_Playlist->UpcomingMedia() : m_Playlist->PrecedingMedia();
+
+    /* Only looked at once for the current clip */
+    m_Preloaded = upcoming;
+
+    if (!upcoming || upcoming == m_Clip || !upcoming->Valid())
+        return;
+
+    /**
+     * The preloaded frames are accounted for on the resident entry of the clip, the size of the frame is
+     * assumed to be the same as the current clip till the clip has been read and restored
+     */
+    auto it = std::find_if(m_Resident.begin(), m_Resident.end(), [&upcoming](const ResidentClip& r) { return r.clip == upcoming; });
+
+    if (it == m_Resident.end())
+        it = m_Resident.insert(m_Resident.begin(), ResidentClip{upcoming, 0});
+    else
+        m_Resident.splice(m_Resident.begin(), m_Resident, it);
+
+    const v_frame_t count = std::min(window, upcoming->Duration());
+    v_frame_t queued = 0;
+
+    for (v_frame_t i = 0; i < count; ++i)
+    {
+        /* Going backwards, the clip gets played from its last frame */
+        v_frame_t frame = forwards ? upcoming->FirstFrame() + i : upcoming->LastFrame() - i;
+
+        if (!upcoming->Contains(frame) || upcoming->Cached(frame))
+            continue;
+
+        /* Room for the upcoming frames is made from the frames which have been played already */
+        while (m_FrameSize > AvailableMemory() && EvictPlayed());
+
+        if (m_FrameSize > AvailableMemory())
+            break;
+
+        it->memory += m_FrameSize;
+        m_ResidentMemory += m_FrameSize;
+
+        /* Lower priority than the frames of the current clip */
+        AddTask(new PreloadFrameTask(upcoming, frame), -1);
+        queued++;
+    }
+
+    VOID_LOG_INFO("Preloading {0} Frames for {1}", queued, upcoming->Name());
+}
+
+void ViewerBuffer::SettlePreload()
+{
+    if (!m_Preloaded)
+        return;
+
+    auto it = std::find_if(m_Resident.begin(), m_Resident.end(), [this](const ResidentClip& r) { return r.clip == m_Preloaded; });
+
+    /* Only looked at again once the preloaded clip has been settled */
+    m_Preloaded = nullptr;
+
+    if (it == m_Resident.end())
+        return;
+
+    /**
+     * The frames were accounted for as they were queued, the ones which were cleared from the pool
+     * before being read are given back, the frame size is the same estimate as the one they were queued with
+     */
+    std::size_t memory = 0;
+
+    for (v_frame_t frame = it->clip->FirstFrame(); frame <= it->clip->LastFrame(); ++frame)
+    {
+        if (it->clip->Contains(frame) && it->clip->Cached(frame))
+            memory += m_FrameSize;
+    }
+
+    m_ResidentMemory -= it->memory;
+    m_ResidentMemory += memory;
+    it->memory = memory;
+
+    if (!memory)
+        m_Resident.erase(it);
+}
+
+void ViewerBuffer::PrefetchEdit()
+{
+    if (m_PlayingComponent != PlayableComponent::Track && m_PlayingComponent != PlayableComponent::Sequence)
+        return;
+
+    bool forwards = m_State == PlayState::Forwards;
+
+    if ((!forwards && m_State != PlayState::Backwards) || !m_Player)
+        return;
+
+    const v_frame_t frame = m_Player->Frame();
+    bool sequence = m_PlayingComponent == PlayableComponent::Sequence;
+
+    /* The edit has been played through, looping around or seeking back gets to it again and it is prefetched once more */
+    if (m_Prefetched && m_Prefetched->InRange(frame))
+        m_Prefetched = nullptr;
+
+    /* The item which gets played after the edit, this could be after a gap as well */
+    SharedTrackItem item;
+
+    if (forwards)
+        item = sequence ? m_Sequence->NextTrackItem(frame) : m_Track->NextTrackItem(frame);
+    else
+        item = sequence ? m_Sequence->PreviousTrackItem(frame) : m_Track->PreviousTrackItem(frame);
+
+    if (!item || item == m_Prefetched)
+        return;
+
+    const SharedMediaClip media = item->GetMedia();
+    const double framerate = media->Framerate() > 0 ? media->Framerate() : 24.0;
+    const v_frame_t window = static_cast<v_frame_t>(framerate * m_PreloadWindow);
+
+    /* Not yet close enough to the edit */
+    if ((forwards ? item->StartFrame() - frame : frame - item->EndFrame()) > window)
+        return;
+
+    m_Prefetched = item;
+
+    const v_frame_t count = std::min(window, item->EndFrame() - item->StartFrame() + 1);
+    v_frame_t requested = 0;
+
+    for (v_frame_t i = 0; i < count; ++i)
+    {
+        /* Going backwards, the item is played from its last frame */
+        v_frame_t f = forwards ? item->StartFrame() + i : item->EndFrame() - i;
+
+        if (Requested(f))
+            continue;
+
+        /* Room for the frames after the edit is made from the frames which have been played already */
+        while (m_FrameSize > AvailableMemory() && EvictPlayed());
+
+        if (!Request(f, false))
+            break;
+
+        /* Ahead of the sequential cache */
+        AddTask(new CacheFrameTask(this, f), 1);
+        ++requested;
+    }
+
+    VOID_LOG_INFO("Prefetching {0} Frames across the edit at {1}", requested, forwards ? item->StartFrame() : item->EndFrame());
+}
+
+bool ViewerBuffer::EvictPlayed()
+{
+    if (m_Framenumbers.Empty())
+        return false;
+
+    const v_frame_t frame = m_Player->Frame();
+
+    if (m_State == PlayState::Backwards)
+    {
+        if (m_Framenumbers.Back() <= frame + m_BackBuffer)
+            return false;
+
+        EvictBack();
+        return true;
+    }
+
+    if (m_Framenumbers.Front() >= frame - m_BackBuffer)
+        return false;
+
+    EvictFront();
+    return true;
+}
+
+void ViewerBuffer::ClearResident()
+{
+    m_Preloaded = nullptr;
+    while (EvictResident());
+}
+
+void ViewerBuffer::RemoveResident(const SharedMediaClip& media)
+{
+    auto it = std::find_if(m_Resident.begin(), m_Resident.end(), [&media](const ResidentClip& r) { return r.clip == media; });
+
+    if (it == m_Resident.end())
+        return;
+
+    it->clip->ClearCache();
+    m_ResidentMemory -= it->memory;
+    m_Resident.erase(it);
+}
+
 SharedPixels ViewerBuffer::Image(const v_frame_t frame)
 {
     /* The active element is a clip */
@@ -250,6 +573,46 @@ BufferData ViewerBuffer::MData(const v_frame_t frame, bool nearest)
     }
 }
 
+std::vector<SharedPixels> ViewerBuffer::Upcoming(const v_frame_t frame, std::size_t count, bool played)
+{
+    std::vector<SharedPixels> images;
+    images.reserve(count);
+
+    const v_frame_t step = ((m_State == PlayState::Backwards) != played) ? -1 : 1;
+
+    for (v_frame_t next = frame + step; images.size() < count && next >= m_Startframe && next <= m_Endframe; next += step)
+    {
+        /* Reading the frame here would block the caller */
+        if (!Cached(next))
+            break;
+
+        /* Frames which are yet to be evaluated are skipped, as evaluating them here would block the caller as well */
+        if (SharedPixels image = Lookup(next))
+            images.push_back(image);
+    }
+
+    return images;
+}
+
+SharedPixels ViewerBuffer::Lookup(const v_frame_t frame)
+{
+    /* The item is looked up directly, the cached track item is for the frame being displayed */
+    if (m_PlayingComponent == PlayableComponent::Track || m_PlayingComponent == PlayableComponent::Sequence)
+    {
+        SharedTrackItem item = (m_PlayingComponent == PlayableComponent::Track) ? m_Track->GetTrackItem(frame) : m_Sequence->GetTrackItem(frame);
+
+        if (!item || !item->InRange(frame) || !item->GetMedia()->Contains(frame + item->GetOffset()))
+            return nullptr;
+
+        return item->GetMedia()->Image(frame + item->GetOffset(), false);
+    }
+
+    if (!m_Clip->InRange(frame) || !m_Clip->Contains(frame))
+        return nullptr;
+
+    return m_Clip->Evaluated(frame, m_Chain ? *m_Chain : EffectChain());
+}
+
 std::vector<SharedPixels> ViewerBuffer::GridFrame(const v_frame_t frame)
 {
     std::vector<SharedPixels> grid;
@@ -269,6 +632,21 @@ std::vector<SharedPixels> ViewerBuffer::GridFrame(const v_frame_t frame)
     return grid;
 }
 
+std::vector<SharedPixels> ViewerBuffer::GridFrame(const v_frame_t frame, std::vector<TextureTransform>& transforms)
+{
+    transforms.clear();
+
+    if (m_PlayingComponent == PlayableComponent::Grid)
+    {
+        transforms.reserve(m_Playlist->Size());
+
+        for (auto& media : m_Playlist->AllMedia())
+            transforms.push_back(media->Geometry());
+    }
+
+    return GridFrame(frame);
+}
+
 SharedMediaClip ViewerBuffer::Media(const v_frame_t frame)
 {
     if (m_PlayingComponent == PlayableComponent::Track)
@@ -293,10 +671,13 @@ BufferData ViewerBuffer::ClipData(const v_frame_t frame, bool nearest)
     BufferData d;
     if (m_Clip->InRange(frame) && m_Clip->Contains(frame))
     {
+        /* Any change to the effects gets the cached frames evaluated again on the cache threads */
+        UpdateChain();
         EnsureCached(frame);
 
-        // Process the image before rendering, if any effect has been applied/pending for process
-        d.image = m_Clip->Evaluate(frame);
+        // The frame has been evaluated as it was cached, only if the effects have just changed is it evaluated here
+        // effects which can be drawn are left for the renderer so that changes to them don't need any evaluation
+        d.image = m_Clip->Evaluate(frame, d.operators);
         d.annotation = m_Clip->Annotation(frame);
         return d;
     }
@@ -386,7 +767,31 @@ bool ViewerBuffer::Playing(const SharedMediaClip& media) const
     /**
      * In other cases the cached track item should tell us if the clip was being played currently
      */
-    return m_CachedTrackItem->GetMedia() == media;
+    return m_CachedTrackItem && m_CachedTrackItem->GetMedia() == media;
+}
+
+bool ViewerBuffer::References(const SharedMediaClip& media) const
+{
+    switch (m_PlayingComponent)
+    {
+        case PlayableComponent::Track:
+            return m_Track->HasMedia(media);
+        case PlayableComponent::Sequence:
+            return m_Sequence->HasMedia(media);
+        case PlayableComponent::Grid:
+        {
+            /* Every media of the playlist is displayed on the grid */
+            if (media == m_Clip)
+                return true;
+
+            const std::vector<SharedMediaClip> all = m_Playlist ? m_Playlist->AllMedia() : std::vector<SharedMediaClip>();
+            return std::find(all.begin(), all.end(), media) != all.end();
+        }
+        case PlayableComponent::Clip:
+        case PlayableComponent::Playlist:
+        default:
+            return media == m_Clip;
+    }
 }
 
 void ViewerBuffer::SetAnnotation(const v_frame_t frame, const Renderer::SharedAnnotation& annotation)
@@ -421,10 +826,11 @@ bool ViewerBuffer::NextMedia()
 {
     if (m_PlayingComponent == PlayableComponent::Playlist)
     {
-        Refresh();
+        Release();
         m_Clip = m_Playlist->NextMedia();
 
         UpdateRange(m_Clip->FirstFrame(), m_Clip->LastFrame());
+        Restore();
         EnsureCached(m_Clip->FirstFrame());
         CacheAvailable();
 
@@ -438,10 +844,11 @@ bool ViewerBuffer::PreviousMedia()
 {
     if (m_PlayingComponent == PlayableComponent::Playlist)
     {
-        Refresh();
+        Release();
         m_Clip = m_Playlist->PreviousMedia();
 
         UpdateRange(m_Clip->FirstFrame(), m_Clip->LastFrame());
+        Restore();
         EnsureCached(m_Clip->FirstFrame());
         CacheAvailable();
 
@@ -460,10 +867,11 @@ bool ViewerBuffer::ResetPlaylistMedia()
      */
     if (m_PlayingComponent == PlayableComponent::Playlist)
     {
-        Refresh();
+        Release();
         m_Clip = m_Playlist->CurrentMedia();
 
         UpdateRange(m_Clip->FirstFrame(), m_Clip->LastFrame());
+        Restore();
         EnsureCached(m_Clip->FirstFrame());
         CacheAvailable();
 
@@ -475,14 +883,11 @@ bool ViewerBuffer::ResetPlaylistMedia()
 
 void ViewerBuffer::StartPlaybackCache(const PlayState& state)
 {
-    if (Completed() || m_State == PlayState::Disabled)
+    if ((Completed() && !PreloadPending()) || m_State == PlayState::Disabled)
         return;
 
     m_State = state;
     m_CacheTimer.start(10);
-
-    if (!m_ThreadPool.activeThreadCount() && !m_Framenumbers.empty())
-        m_LastCached = m_State == PlayState::Forwards ? m_Framenumbers.back() : m_Framenumbers.front();
 }
 
 void ViewerBuffer::StopPlaybackCache()
@@ -509,13 +914,20 @@ void ViewerBuffer::StopCaching()
     /* Wait for the remaining to be done */
     m_ThreadPool.waitForDone();
 
+    /* Preloaded frames which never got read are not held in memory */
+    SettlePreload();
+
     m_Player->ClearCachedFrames();
     m_LastCached = m_Player->Frame();
+
+    /* Whatever was queued across the edit may not have made it, caching starts over from the playhead */
+    m_Prefetched = nullptr;
 }
 
 void ViewerBuffer::ResumeCaching()
 {
     m_State = PlayState::Forwards;
+    m_Prefetched = nullptr;
     CacheAvailable();
 }
 
@@ -531,11 +943,20 @@ void ViewerBuffer::Update()
         return;
     }
 
+    UpdateChain();
+
+    /**
+     * Playlist looks ahead at the clip to be played after the current one, tracks look ahead across edits
+     * these evict and request frames as well, so wait on the running cache process same as the rest
+     */
+    Preload();
+    PrefetchEdit();
+
     if (m_State == PlayState::Forwards && !Completed())
         CacheNext();
     else if (m_State == PlayState::Backwards && !Completed())
         CachePrevious();
-    else
+    else if (!PreloadPending())
         m_CacheTimer.stop();
 
     VOID_LOG_INFO("Update Cache.....");
@@ -552,10 +973,25 @@ void ViewerBuffer::UpdateRange(v_frame_t start, v_frame_t end)
      * being played
      */
     m_BackBuffer = std::min(10, std::max(3, static_cast<int>(((m_Endframe - m_Startframe) + 1) * 0.02)));
+
+    /**
+     * The cache index is laid out for the whole range, so that any frame in the range
+     * can be looked up, requested or evicted without having to search for it
+     */
+    m_Framenumbers.Reset(static_cast<std::size_t>(std::max<v_frame_t>(m_Endframe - m_Startframe, 0)) + 1);
+    m_Requested.Reset(m_Startframe, m_Endframe);
+    m_Buffered.Reset(m_Startframe, m_Endframe);
 }
 
 bool ViewerBuffer::Request(v_frame_t frame, bool evict)
 {
+    /**
+     * The frame has already been requested (or is outside of the range of the buffer)
+     * there isn't anything to account for in terms of memory for this frame
+     */
+    if (!m_Requested.InRange(frame) || Requested(frame))
+        return false;
+
     /**
      * Size isn't yet set so we can definitely go for caching the first frame
      * well, unless the first frame itself is more than the max available memory
@@ -563,7 +999,7 @@ bool ViewerBuffer::Request(v_frame_t frame, bool evict)
      */
     if (!m_FrameSize)
     {
-        m_State == PlayState::Backwards ? m_Framenumbers.push_front(frame) : m_Framenumbers.push_back(frame);
+        Push(frame);
         return true;
     }
 
@@ -573,26 +1009,23 @@ bool ViewerBuffer::Request(v_frame_t frame, bool evict)
      */
     if (evict && Completed())
     {
-        m_CacheTimer.stop();
+        if (!PreloadPending())
+            m_CacheTimer.stop();
+
         return false;
     }
 
-    if (m_FrameSize > AvailableMemory())
+    /* The active component takes precedence, make room by letting go of the clips played the longest ago */
+    while (FrameCost() > AvailableMemory() && EvictResident());
+
+    if (FrameCost() > AvailableMemory())
     {
         if (evict)
         {
-            if (m_State == PlayState::Backwards)
-            {
-                EvictBack();
-                m_Framenumbers.push_front(frame);
-            }
-            else
-            {
-                EvictFront();
-                m_Framenumbers.push_back(frame);
-            }
+            m_State == PlayState::Backwards ? EvictBack() : EvictFront();
+            Push(frame);
 
-            m_UsedMemory += m_FrameSize;
+            m_UsedMemory += FrameCost();
             return true;
         }
 
@@ -600,16 +1033,26 @@ bool ViewerBuffer::Request(v_frame_t frame, bool evict)
         return false;
     }
 
-    m_UsedMemory += m_FrameSize;
-    m_State == PlayState::Backwards ? m_Framenumbers.push_front(frame) : m_Framenumbers.push_back(frame);
+    m_UsedMemory += FrameCost();
+    Push(frame);
     return true;
 }
 
-void ViewerBuffer::Cache(v_frame_t frame)
+void ViewerBuffer::Push(v_frame_t frame)
 {
+    m_State == PlayState::Backwards ? m_Framenumbers.PushFront(frame) : m_Framenumbers.PushBack(frame);
+    m_Requested.Set(frame);
+}
+
+void ViewerBuffer::Cache(v_frame_t frame, const SharedEffectChain& chain)
+{
+    /**
+     * This gets invoked from the cache threads, the item is looked up from the track/sequence directly
+     * as the cached track item is only for the frames around the playhead
+     */
     if (m_PlayingComponent == PlayableComponent::Track)
     {
-        SharedTrackItem item = ItemFromTrack(frame);
+        SharedTrackItem item = m_Track->GetTrackItem(frame);
         if (item)
         {
             item->CacheFrame(frame);
@@ -623,7 +1066,7 @@ void ViewerBuffer::Cache(v_frame_t frame)
 
     if (m_PlayingComponent == PlayableComponent::Sequence)
     {
-        if (SharedTrackItem item = ItemFromSequence(frame))
+        if (SharedTrackItem item = m_Sequence->GetTrackItem(frame))
         {
             item->CacheFrame(frame);
             m_FrameSize = item->FrameSize();
@@ -639,21 +1082,37 @@ void ViewerBuffer::Cache(v_frame_t frame)
         m_Clip->CacheFrame(frame);
         m_FrameSize = m_Clip->FrameSize();
 
+        /* The evaluated copy is made here along with the read, rather than when the frame gets displayed */
+        if (chain && !chain->Empty())
+            m_Clip->Evaluate(frame, *chain);
+
         Store(frame);
     }
 }
 
 void ViewerBuffer::EvictFront()
 {
-    v_frame_t frame = m_Framenumbers.front();
+    if (!m_Framenumbers.Empty())
+        Evict(m_Framenumbers.PopFront());
+}
+
+void ViewerBuffer::EvictBack()
+{
+    if (!m_Framenumbers.Empty())
+        Evict(m_Framenumbers.PopBack());
+}
 
+void ViewerBuffer::Evict(v_frame_t frame)
+{
     switch (m_PlayingComponent)
     {
         case PlayableComponent::Track:
-            ItemFromTrack(frame)->UncacheFrame(frame);
+            if (SharedTrackItem item = m_Track->GetTrackItem(frame))
+                item->UncacheFrame(frame);
             break;
         case PlayableComponent::Sequence:
-            ItemFromSequence(frame)->UncacheFrame(frame);
+            if (SharedTrackItem item = m_Sequence->GetTrackItem(frame))
+                item->UncacheFrame(frame);
             break;
         case PlayableComponent::Clip:
         case PlayableComponent::Grid:
@@ -663,59 +1122,90 @@ void ViewerBuffer::EvictFront()
                 m_Clip->UncacheFrame(frame);
     }
 
-    m_UsedMemory -= m_FrameSize;
+    m_UsedMemory -= FrameCost();
+    m_Requested.Unset(frame);
 
-    m_Framenumbers.pop_front();
-    m_Buffered.erase(frame);
-    m_Player->RemoveCachedFrame(frame);
+    /* Only update the timeline if the frame had actually made it to the cache */
+    if (m_Buffered.Unset(frame))
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Player->RemoveCachedFrame(frame);
+    }
 }
 
-void ViewerBuffer::EvictBack()
+void ViewerBuffer::Store(v_frame_t frame)
 {
-    v_frame_t frame = m_Framenumbers.back();
-
-    switch (m_PlayingComponent)
+    /**
+     * Marking the frame on the bitmap does not need the lock, only the timeline needs to be guarded
+     * and is updated only when the frame was not already marked as cached
+     */
+    if (m_Buffered.Set(frame))
     {
-        case PlayableComponent::Track:
-            ItemFromTrack(frame)->UncacheFrame(frame);
-            break;
-        case PlayableComponent::Sequence:
-            ItemFromSequence(frame)->UncacheFrame(frame);
-            break;
-        case PlayableComponent::Clip:
-        case PlayableComponent::Grid:
-        case PlayableComponent::Playlist:
-        default:
-            if (m_Clip->Valid() && m_Clip->Contains(frame))
-                m_Clip->UncacheFrame(frame);
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Player->AddCacheFrame(frame);
     }
-
-    m_UsedMemory -= m_FrameSize;
-    m_Framenumbers.pop_back();
-    m_Buffered.erase(frame);
-    m_Player->RemoveCachedFrame(frame);
 }
 
-void ViewerBuffer::Store(v_frame_t frame)
+void ViewerBuffer::UpdateChain()
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    /* Only a clip (played on its own or from a playlist) has its effects evaluated */
+    const bool clip = m_PlayingComponent == PlayableComponent::Clip || m_PlayingComponent == PlayableComponent::Playlist;
+    const SharedEffectChain chain = (clip && m_Clip->Valid()) ? m_Clip->Chain() : nullptr;
+
+    /* The clip keeps the same chain till any of its effects change */
+    if (chain == m_Chain)
+        return;
+
+    const bool evaluated = chain && !chain->Empty();
+    const bool wasEvaluated = m_Chain && !m_Chain->Empty();
 
-    m_Buffered.insert(frame);
-    m_Player->AddCacheFrame(frame);
+    m_Chain = chain;
+
+    /* Nothing was evaluated and nothing is to be, the frames stay as they are */
+    if (!evaluated && !wasEvaluated)
+        return;
+
+    /**
+     * Whatever was queued with the earlier chain is queued again with this one, the tasks which are already running
+     * are left to finish, their evaluated copy is replaced by the task which is queued for the same frame
+     */
+    m_ThreadPool.clear();
+    SettlePreload();
+
+    /* The frames are accounted for their evaluated copies (or without those), making room if that is over the budget */
+    m_UsedMemory = m_Framenumbers.Size() * FrameCost();
+
+    if (m_Player && m_UsedMemory + m_ResidentMemory > m_MaxMemory)
+        Shrink();
+
+    const v_frame_t duration = m_Endframe - m_Startframe + 1;
+    const v_frame_t start = m_Player ? std::clamp<v_frame_t>(m_Player->Frame(), m_Startframe, m_Endframe) : m_Startframe;
+    const v_frame_t step = m_State == PlayState::Backwards ? -1 : 1;
+
+    /* Starting from the playhead in the direction of playback, so the frames to be displayed next are evaluated first */
+    for (v_frame_t i = 0; i < duration; ++i)
+    {
+        const v_frame_t frame = m_Startframe + ((start - m_Startframe + i * step) % duration + duration) % duration;
+
+        if (!Requested(frame))
+            continue;
+
+        if (evaluated || !Cached(frame))
+            AddTask(new CacheFrameTask(this, frame));
+        else
+            m_Clip->ReleaseEvaluated(frame);
+    }
 }
 
 void ViewerBuffer::EnsureCached(v_frame_t frame)
 {
-    if (m_Buffered.find(frame) == m_Buffered.end())
+    if (!Cached(frame))
     {
         VOID_LOG_INFO("Force Caching Frame: {0}", frame);
-        {
-            std::lock_guard<std::mutex> lock(m_Mutex);
-            m_LastCached = frame;
-        }
+        m_LastCached = frame;
 
         Request(frame, true);
-        Cache(frame);
+        Cache(frame, m_Chain);
     }
 }
 
@@ -730,6 +1220,8 @@ void ViewerBuffer::CacheAvailable()
     if (m_State == PlayState::Disabled)
         return;
 
+    UpdateChain();
+
     /**
      * This is invoked whenever the media is set/changed on the player buffer
      * so the usual direction is Forwards, unless we were going backwards
@@ -738,26 +1230,28 @@ void ViewerBuffer::CacheAvailable()
     {
         for (v_frame_t frame = m_Endframe; frame >= m_Startframe; --frame)
         {
-            if (Cached(frame))
+            if (Requested(frame))
                 continue;
 
             if (!Request(frame, false))
                 break;
 
-            AddTask(new CachePreviousFrameTask(this));
+            m_LastCached = frame;
+            AddTask(new CacheFrameTask(this, frame));
         }
     }
     else
     {
         for (v_frame_t frame = m_Startframe; frame <= m_Endframe; ++frame)
         {
-            if (Cached(frame))
+            if (Requested(frame))
                 continue;
 
             if (!Request(frame, false))
                 break;
 
-            AddTask(new CacheNextFrameTask(this));
+            m_LastCached = frame;
+            AddTask(new CacheFrameTask(this, frame));
         }
     }
 }
@@ -785,74 +1279,39 @@ bool ViewerBuffer::Completed() const
      * and the end frames present
      *
      */
-    return m_Framenumbers.size() >= InternalDuration();
-}
-
-v_frame_t ViewerBuffer::GetNextFrame()
-{
-    std::lock_guard<std::mutex> lock(m_Mutex);
-
-    v_frame_t frame = 0;
-
-    if (m_LastCached >= m_Endframe)
-        frame = m_Startframe;
-    else
-        frame = ++m_LastCached;
-
-    m_LastCached = frame;
-
-    return frame;
-}
-
-v_frame_t ViewerBuffer::GetPreviousFrame()
-{
-    std::lock_guard<std::mutex> lock(m_Mutex);
-
-    v_frame_t frame = 0;
-
-    if (m_LastCached <= m_Startframe)
-        frame = m_Endframe;
-    else
-        frame = --m_LastCached;
-
-    /* Update the last cached so that the next frame is the next to this */
-    m_LastCached = frame;
-
-    return frame;
-}
-
-void ViewerBuffer::CacheNextFrame()
-{
-    Cache(GetNextFrame());
-}
-
-void ViewerBuffer::CachePreviousFrame()
-{
-    Cache(GetPreviousFrame());
+    return m_Framenumbers.Size() >= static_cast<std::size_t>(InternalDuration());
 }
 
 void ViewerBuffer::CacheNext()
 {
     v_frame_t frame = m_LastCached;
 
-    /* Determine how many frames are used up and can be removed */
-    while (!m_Framenumbers.empty())
+    /**
+     * Determine how many frames are used up and can be removed
+     * this never goes around the range more than once, as at that point every frame has been looked at
+     */
+    for (int i = 0; i < InternalDuration() && !m_Framenumbers.Empty(); ++i)
     {
-        // This might be a good idea to keep? in case all the frames are cached?
-        // if (Completed())
-        //     break;
-
         /* Ensure the cached frame is just between the current frame and the back buffer */
-        if (m_Player->Frame() - m_BackBuffer < m_Framenumbers.front() && m_Framenumbers.front() <= m_Player->Frame())
+        if (m_Player->Frame() - m_BackBuffer < m_Framenumbers.Front() && m_Framenumbers.Front() <= m_Player->Frame())
             break;
 
         frame++;
 
         if (frame > InternalEndframe())
+        {
+            /* A playlist moves on to the next clip instead of looping over the current one */
+            if (m_PlayingComponent == PlayableComponent::Playlist)
+                break;
+
             frame = InternalStartframe();
+        }
 
-        Request(frame, true);
-        AddTask(new CacheNextFrameTask(this));
+        if (Request(frame, true))
+        {
+            m_LastCached = frame;
+            AddTask(new CacheFrameTask(this, frame));
+        }
     }
 }
 
@@ -860,26 +1319,102 @@ void ViewerBuffer::CachePrevious()
 {
     v_frame_t frame = m_LastCached;
 
-    /* Determine how many frames are used up and can be removed */
-    while (!m_Framenumbers.empty())
+    /**
+     * Determine how many frames are used up and can be removed
+     * this never goes around the range more than once, as at that point every frame has been looked at
+     */
+    for (int i = 0; i < InternalDuration() && !m_Framenumbers.Empty(); ++i)
     {
         /* Ensure the cached frame is just between the current frame and the back buffer */
-        if (m_Player->Frame() + m_BackBuffer >= m_Framenumbers.back() && m_Framenumbers.back() >= m_Player->Frame())
+        if (m_Player->Frame() + m_BackBuffer >= m_Framenumbers.Back() && m_Framenumbers.Back() >= m_Player->Frame())
             break;
 
         frame--;
 
         if (frame < InternalStartframe())
+        {
+            /* A playlist moves on to the previous clip instead of looping over the current one */
+            if (m_PlayingComponent == PlayableComponent::Playlist)
+                break;
+
             frame = InternalEndframe();
+        }
 
-        Request(frame, true);
-        AddTask(new CachePreviousFrameTask(this));
+        if (Request(frame, true))
+        {
+            m_LastCached = frame;
+            AddTask(new CacheFrameTask(this, frame));
+        }
     }
 }
 
+void ViewerBuffer::SetMemoryBudget(std::size_t bytes)
+{
+    const std::size_t previous = m_MaxMemory;
+    m_MaxMemory = bytes;
+
+    if (!m_Player)
+        return;
+
+    if (UsedMemory() > m_MaxMemory)
+    {
+        VOID_LOG_INFO("{0} Cache Memory Reduced: {1} MB", m_Name, m_MaxMemory / (1024 * 1024));
+        Shrink();
+    }
+    else if (m_MaxMemory > previous && !m_CacheTimer.isActive() && !Completed())
+    {
+        /* More room, fill it up with what could not be cached before */
+        CacheAvailable();
+    }
+}
+
+void ViewerBuffer::Shrink()
+{
+    /**
+     * This runs on the GUI thread, so the pool isn't waited on, frames which are being read (or queued to be)
+     * have already been accounted for and are left alone, only the frames which have made it to the cache are
+     * let go of, any new requests are granted only within the reduced memory
+     */
+    const bool backwards = m_State == PlayState::Backwards;
+    const v_frame_t frame = m_Player->Frame();
+
+    while (m_UsedMemory + m_ResidentMemory > m_MaxMemory && EvictResident());
+
+    /* Frames which have been played */
+    while (m_UsedMemory + m_ResidentMemory > m_MaxMemory && !m_Framenumbers.Empty())
+    {
+        const v_frame_t played = backwards ? m_Framenumbers.Back() : m_Framenumbers.Front();
+
+        if ((backwards ? played <= frame : played >= frame) || !EvictCached(!backwards))
+            break;
+    }
+
+    /* The frames farthest ahead of the playhead */
+    while (m_UsedMemory + m_ResidentMemory > m_MaxMemory && EvictCached(backwards));
+
+    /* Caching resumes from the playhead within the reduced memory */
+    m_LastCached = frame;
+}
+
+bool ViewerBuffer::EvictCached(bool front)
+{
+    if (m_Framenumbers.Empty())
+        return false;
+
+    /* The frame is still being read */
+    if (!Cached(front ? m_Framenumbers.Front() : m_Framenumbers.Back()))
+        return false;
+
+    front ? EvictFront() : EvictBack();
+    return true;
+}
+
 void ViewerBuffer::SettingsUpdated()
 {
-    SetMaxMemory(VoidPreferences::Instance().GetCacheMemory());
+    /* With automatic memory, the Player sets the budget for the buffer */
+    if (!VoidPreferences::Instance().GetCacheAutoMemory())
+        SetMaxMemory(VoidPreferences::Instance().GetCacheMemory());
+
     SetMaxThreads(VoidPreferences::Instance().GetCacheThreads());
 
     VOID_LOG_INFO("Cache Settings Updated.");
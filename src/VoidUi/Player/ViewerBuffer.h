@@ -5,10 +5,10 @@
 #define _VOID_VIEWER_BUFFER_H
 
 /* STD */
-#include <deque>
+#include <list>
 #include <memory>
 #include <mutex>
-#include <unordered_set>
+#include <vector>
 
 /* Qt */
 #include <QColor>
@@ -19,6 +19,7 @@
 
 /* Internal */
 #include "Definition.h"
+#include "VoidCore/CacheIndex.h"
 #include "VoidObjects/Sequence/Track.h"
 #include "VoidObjects/Sequence/Sequence.h"
 #include "VoidObjects/Media/MediaClip.h"
@@ -47,6 +48,8 @@ struct BufferData
 {
     SharedPixels image = nullptr;
     Renderer::SharedAnnotation annotation = nullptr;
+    /* Operators to be applied on the image while drawing */
+    std::vector<ImageOp*> operators;
 
     bool Valid() const { return (bool)image; }
     explicit operator bool() const { return (bool)image; }
@@ -56,24 +59,32 @@ class VOID_API ViewerBuffer : public QObject
 {
     Q_OBJECT
 
-    class CacheNextFrameTask : public QRunnable
+    /**
+     * Caches the frame it has been created for, the frame is requested on the main thread before the task
+     * is added, which allows frames to be requested out of order (e.g. ahead of an edit)
+     * The frame is evaluated with the chain of effects the buffer had when the task was created
+     */
+    class CacheFrameTask : public QRunnable
     {
     public:
-        explicit CacheNextFrameTask(ViewerBuffer* parent) : m_Parent(parent) {}
-        inline void run() override { m_Parent->CacheNextFrame(); }
+        CacheFrameTask(ViewerBuffer* parent, v_frame_t frame) : m_Parent(parent), m_Frame(frame), m_Chain(parent->m_Chain) {}
+        inline void run() override { m_Parent->Cache(m_Frame, m_Chain); }
 
     private:
         ViewerBuffer* m_Parent;
+        v_frame_t m_Frame;
+        SharedEffectChain m_Chain;
     };
 
-    class CachePreviousFrameTask : public QRunnable
+    class PreloadFrameTask : public QRunnable
     {
     public:
-        explicit CachePreviousFrameTask(ViewerBuffer* parent) : m_Parent(parent) {}
-        inline void run() override { m_Parent->CachePreviousFrame(); }
+        PreloadFrameTask(const SharedMediaClip& clip, v_frame_t frame) : m_Clip(clip), m_Frame(frame) {}
+        inline void run() override { m_Clip->CacheFrame(m_Frame); }
 
     private:
-        ViewerBuffer* m_Parent;
+        SharedMediaClip m_Clip;
+        v_frame_t m_Frame;
     };
 
 public: /* Enums */
@@ -116,6 +127,15 @@ public:
 
     inline void SetActivePlayer(Player* player) { m_Player = player; }
     inline void SetMaxMemory(unsigned long long gigs) { m_MaxMemory = gigs * 1024 * 1024 * 1024; }
+
+    /**
+     * Sets the share of the automatic memory budget (in bytes) for the buffer, the Player computes the budget
+     * for both the buffers, frames are evicted if the buffer is over its share and caching resumes if it grew
+     */
+    void SetMemoryBudget(std::size_t bytes);
+
+    /* Memory held by the buffer, the cached frames along with the resident clips */
+    inline std::size_t UsedMemory() const { return m_UsedMemory + m_ResidentMemory; }
     inline void SetMaxThreads(unsigned int count) { m_ThreadPool.setMaxThreadCount(count); }
 
     void StartPlaybackCache(const PlayState& state = PlayState::Forwards);
@@ -140,10 +160,22 @@ public:
     void ResumeCaching();
 
     void Recache();
+
+    /**
+     * Clears the cache of the active component along with any clips which have been kept resident
+     */
     void ClearCache();
 
     void EnsureCached(v_frame_t frame);
 
+    /**
+     * @brief Removes the media from the clips which are kept resident in memory, clearing its cache.
+     * This is needed when the media is going away and should not be held by the buffer anymore.
+     *
+     * @param media Media clip to be removed.
+     */
+    void RemoveResident(const SharedMediaClip& media);
+
     /**
      * Returns the current Component Type which is playing in the buffer
      */
@@ -169,6 +201,18 @@ public:
      */
     BufferData MData(const v_frame_t frame, bool nearest = false);
 
+    /**
+     * @brief Returns the images of the frames following the given frame in the direction of playback,
+     * only the frames which have already been cached are returned (stopping at the first one that isn't).
+     * Nothing gets read or evaluated, frames which are yet to be evaluated with the effects of the clip are skipped.
+     *
+     * @param frame Frame number being displayed.
+     * @param count Max number of images to return.
+     * @param played Whether the frames preceding the given frame (the ones which have been played) are required.
+     * @return std::vector<SharedPixels> Images in the order they are going to be displayed (or were, most recent first).
+     */
+    std::vector<SharedPixels> Upcoming(const v_frame_t frame, std::size_t count, bool played = false);
+
     /**
      * @brief Returns a set of images that are to be shown in the Grid of Images (Layout/Contact Sheet)
      * 
@@ -177,6 +221,16 @@ public:
      */
     std::vector<SharedPixels> GridFrame(const v_frame_t frame);
 
+    /**
+     * @brief Returns the set of images for the Grid along with the transforms of the geometric effects of each media
+     * which get applied while drawing.
+     *
+     * @param frame Frame number.
+     * @param transforms Filled in with the transform for each of the images.
+     * @return std::vector<SharedPixels> Set of image data from the Media.
+     */
+    std::vector<SharedPixels> GridFrame(const v_frame_t frame, std::vector<TextureTransform>& transforms);
+
     /**
      * @brief Returns the Media from the active component.
      *
@@ -205,6 +259,12 @@ public:
      */
     bool Playing(const SharedMediaClip& media) const;
 
+    /**
+     * Returns whether the provided media clip is a part of the active component, i.e. the clip itself,
+     * any of the media on the grid or any item on the track or the sequence, not just the one at the playhead
+     */
+    bool References(const SharedMediaClip& media) const;
+
     /**
      * Active state of the Viewer Buffer
      */
@@ -262,6 +322,18 @@ signals:
     void updated();
     void playlistUpdated(Playlist*);
 
+private: /* Structs */
+    /**
+     * A Clip which is no longer being played on the buffer, but its cached frames are still kept
+     * in memory so that switching back to it does not need any of the frames to be read again
+     */
+    struct ResidentClip
+    {
+        SharedMediaClip clip;
+        /* Bytes used by the cached frames of the clip */
+        std::size_t memory;
+    };
+
 private: /* Members */
     /**
      * Playable Entities
@@ -300,6 +372,32 @@ private: /* Members */
     std::size_t m_UsedMemory;
     std::size_t m_FrameSize;
 
+    /**
+     * Clips which were played recently on the buffer, most recent first
+     * These share the memory limit with the active component and get evicted, least recently played first,
+     * when the active component needs memory for caching
+     */
+    std::list<ResidentClip> m_Resident;
+    std::size_t m_ResidentMemory;
+
+    /**
+     * The clip from the playlist which has been preloaded to be played next
+     * and the number of seconds before the end of the current clip when the preload begins
+     */
+    SharedMediaClip m_Preloaded;
+    double m_PreloadWindow;
+
+    /**
+     * The track item after the upcoming edit (in the direction of playback) which has been prefetched
+     */
+    SharedTrackItem m_Prefetched;
+
+    /**
+     * The chain of effects of the clip which the frames are evaluated with as they are cached
+     * Each cached frame holds its evaluated copy alongside the original, and is accounted for both
+     */
+    SharedEffectChain m_Chain;
+
     v_frame_t m_Startframe, m_Endframe;
     v_frame_t m_LastCached;
 
@@ -309,8 +407,18 @@ private: /* Members */
     QTimer m_CacheTimer;
     std::mutex m_Mutex;
 
-    std::deque<v_frame_t> m_Framenumbers;
-    std::unordered_set<v_frame_t> m_Buffered;
+    /**
+     * Frames in the order they have been requested to be cached, the frames at either end of this
+     * get evicted when the memory limit is reached based on the direction of caching
+     */
+    FrameRing m_Framenumbers;
+
+    /**
+     * Frame offset indexed bitmaps of the frames which have been requested for caching and the ones
+     * which have actually been cached (read), both are reset with the range of the buffer
+     */
+    FrameBitmap m_Requested;
+    FrameBitmap m_Buffered;
 
 private: /* Methods */
     /**
@@ -331,13 +439,92 @@ private: /* Methods */
 
     bool Completed() const;
 
-    inline std::size_t AvailableMemory() const { return m_MaxMemory - m_UsedMemory; }
+    /**
+     * Bytes used by a cached frame, twice the size of the frame if the frames hold an evaluated copy
+     */
+    inline std::size_t FrameCost() const { return (m_Chain && !m_Chain->Empty()) ? m_FrameSize * 2 : m_FrameSize; }
+
+    /**
+     * Takes the chain of effects from the active clip, if that has changed since, the frames which have been
+     * requested are queued again to be evaluated with it and the memory is accounted for the evaluated copies
+     */
+    void UpdateChain();
+
+    inline std::size_t AvailableMemory() const
+    {
+        return m_MaxMemory > m_UsedMemory + m_ResidentMemory ? m_MaxMemory - (m_UsedMemory + m_ResidentMemory) : 0;
+    }
+
+    /**
+     * Releases the active component from the buffer, if the active component is a clip, its cached
+     * frames are kept resident, else the cache is cleared as it was before
+     */
+    void Release();
+
+    /**
+     * Restores the cache index from an active clip, if it was resident in memory
+     * returns true if the clip was resident
+     */
+    bool Restore();
+
+    /**
+     * Preloads the first frames of the clip which plays next on the playlist (based on the direction)
+     * when the playhead is towards the end of the current clip, reading the frames also opens the reader of
+     * the clip so that the switch to it is without a stall
+     * The preloaded frames are kept as a resident clip which gets restored once the playlist switches to it
+     */
+    void Preload();
+
+    /**
+     * Accounts the resident memory of the preloaded clip for the frames which were actually read
+     * and lets the upcoming clip be preloaded again, invoked once the pool has been cleared
+     */
+    void SettlePreload();
+
+    /**
+     * Whether the upcoming clip from the playlist is still to be preloaded
+     */
+    [[nodiscard]] inline bool PreloadPending() const
+    {
+        return m_PlayingComponent == PlayableComponent::Playlist && !m_Preloaded && m_Playlist && m_Playlist->Size() > 1;
+    }
+
+    /**
+     * Prefetches the head of the track item after the upcoming edit on a track or sequence, when the playhead
+     * is within the preload window of the edit, the frames are requested at a higher priority than the
+     * sequential cache so that the reader of the item is opened and its frames are read before the cut
+     */
+    void PrefetchEdit();
+
+    /**
+     * Evicts a frame of the active clip which has already been played, returns false if there aren't any
+     */
+    bool EvictPlayed();
+
+    /**
+     * Evicts the least recently played resident clip, returns false if there aren't any
+     * The clip being preloaded and the ones referenced by the active component of either buffer are left alone
+     */
+    bool EvictResident();
+    void ClearResident();
+
+    /**
+     * Clears the cache of the active component only
+     */
+    void ClearActive();
 
     /**
      * Frame Eviction from the cached array
      */
     void EvictFront();
     void EvictBack();
+    void Evict(v_frame_t frame);
+
+    /**
+     * Evicts the frame at the front (or the back) only if it has made it to the cache,
+     * returns false if there isn't one or it is still being read
+     */
+    bool EvictCached(bool front);
 
     /**
      * Update to refresh the cache to available frames after removing the frames
@@ -346,8 +533,21 @@ private: /* Methods */
     void Update();
 
     void UpdateRange(v_frame_t start, v_frame_t end);
+
+    /**
+     * Evicts frames till the used memory is within the max memory, resident clips go first, followed by
+     * frames which have been played and lastly the frames farthest ahead of the playhead
+     * Only the frames which have been cached are evicted, nothing is waited on
+     */
+    void Shrink();
     inline void AddTask(QRunnable* runnable, int priority = 0) { m_ThreadPool.start(runnable, priority); }
-    inline bool Cached(v_frame_t frame) const { return m_Buffered.find(frame) != m_Buffered.end(); }
+    inline bool Cached(v_frame_t frame) const { return m_Buffered.Test(frame); }
+    inline bool Requested(v_frame_t frame) const { return m_Requested.Test(frame); }
+
+    /**
+     * Adds the frame to the requested frames at the end based on the direction of caching
+     */
+    void Push(v_frame_t frame);
 
     /**
      * A Cache process which caches all frames till the memory size allows
@@ -368,15 +568,17 @@ private: /* Methods */
 
     /**
      * Cache the provided frame for the media, if the frame is already cached nothing happens in terms
-     * of memory usage
+     * of memory usage, the frame of a clip is then evaluated with the chain (if there is one)
+     */
+    void Cache(v_frame_t frame, const SharedEffectChain& chain);
+
+    /**
+     * Returns the image which is already there for the frame (evaluated, if the clip has effects to evaluate)
+     * nullptr if there isn't one yet
      */
-    void Cache(v_frame_t frame);
+    SharedPixels Lookup(const v_frame_t frame);
     void Store(v_frame_t frame);
 
-    v_frame_t GetNextFrame();
-    v_frame_t GetPreviousFrame();
-    void CacheNextFrame();
-    void CachePreviousFrame();
     void CacheNext();
     void CachePrevious();
 
@@ -39,6 +39,12 @@ void CachePreferences::Reset()
     unsigned int memory = VoidPreferences::Instance().GetSetting(Settings::CacheMemory).toUInt();
     m_CacheBox->setValue(memory);
 
+    bool automatic = VoidPreferences::Instance().GetCacheAutoMemory();
+    m_AutoMemoryCheck->setChecked(automatic);
+    m_CacheBox->setEnabled(!automatic);
+
+    m_TextureMemoryBox->setValue(VoidPreferences::Instance().GetCacheTextureMemory());
+
     unsigned int threads = VoidPreferences::Instance().GetSetting(Settings::CacheThreads).toUInt();
     m_ThreadsBox->setValue(threads);
 }
@@ -47,6 +53,8 @@ void CachePreferences::Save()
 {
     /* Get and save the value of the Cache Memory size and Thread Count */
     VoidPreferences::Instance().Set(Settings::CacheMemory, QVariant(m_CacheBox->value()));
+    VoidPreferences::Instance().Set(Settings::CacheAutoMemory, QVariant(m_AutoMemoryCheck->isChecked()));
+    VoidPreferences::Instance().Set(Settings::CacheTextureMemory, QVariant(m_TextureMemoryBox->value()));
     VoidPreferences::Instance().Set(Settings::CacheThreads, QVariant(m_ThreadsBox->value()));
 }
 
@@ -59,11 +67,22 @@ void CachePreferences::Build()
     m_CacheDescription = new QLabel("Controls the amount of memory (RAM) reserved for temporary data (cache) storage during processing.\n\n\
 A larger cache can improve performance by reducing the need to recompute or reload frequently accessed data.\n\
  Lower Values: Running on a low memory system or want to conserve for other processes.\n\
- Higher Values: If you have plenty of RAM or viewing High resolution content.");
+ Higher Values: If you have plenty of RAM or viewing High resolution content.\n\n\
+ Automatic: The cache grows while memory is free and shrinks when the system (or container) comes under memory pressure.\n\n\
+ GPU Texture Memory: Frames around the playhead (and loops which fit) are kept on the GPU to be displayed without being uploaded again.");
 
     m_CacheLabel = new QLabel("Cache Memory Size");
     m_CacheBox = new QSpinBox;
 
+    m_AutoMemoryLabel = new QLabel("Automatic Cache Memory");
+    m_AutoMemoryCheck = new QCheckBox();
+
+    m_TextureMemoryLabel = new QLabel("GPU Texture Memory (MB)");
+    m_TextureMemoryBox = new QSpinBox;
+
+    /* The fixed size only applies when the cache is not managed automatically */
+    connect(m_AutoMemoryCheck, &QCheckBox::toggled, m_CacheBox, [this](bool checked) { m_CacheBox->setEnabled(!checked); });
+
     m_ThreadsDescription = new QLabel("Sets the maximum number of threads that can run concurrently in the thread pool.\n\n\
  Lower Count: Running on a lower power device with lesser overall cores.\n\
  Higher Count: Want faster throughput for cache operations and have plenty cores available for multiprocessing.");
@@ -75,15 +94,19 @@ A larger cache can improve performance by reducing the need to recompute or relo
     m_Layout->addWidget(m_CacheDescription, 0, 0, 1, 5);
     m_Layout->addWidget(m_CacheLabel, 1, 0);
     m_Layout->addWidget(m_CacheBox, 1, 1);
+    m_Layout->addWidget(m_AutoMemoryLabel, 2, 0);
+    m_Layout->addWidget(m_AutoMemoryCheck, 2, 1);
+    m_Layout->addWidget(m_TextureMemoryLabel, 3, 0);
+    m_Layout->addWidget(m_TextureMemoryBox, 3, 1);
 
-    m_Layout->addItem(new QSpacerItem(10, 20), 2, 3);
+    m_Layout->addItem(new QSpacerItem(10, 20), 4, 3);
 
-    m_Layout->addWidget(m_ThreadsDescription, 3, 0, 1, 5);
-    m_Layout->addWidget(m_ThreadsLabel, 4, 0);
-    m_Layout->addWidget(m_ThreadsBox, 4, 1);
+    m_Layout->addWidget(m_ThreadsDescription, 5, 0, 1, 5);
+    m_Layout->addWidget(m_ThreadsLabel, 6, 0);
+    m_Layout->addWidget(m_ThreadsBox, 6, 1);
 
     /* Spacer */
-    m_Layout->setRowStretch(5, 1);
+    m_Layout->setRowStretch(7, 1);
 }
 
 void CachePreferences::Setup()
@@ -101,9 +124,14 @@ void CachePreferences::Setup()
     m_ThreadsBox->setMinimum(1);
     m_ThreadsBox->setMaximum(maxThreads);
 
+    m_TextureMemoryBox->setMinimum(128);
+    m_TextureMemoryBox->setMaximum(65536);
+    m_TextureMemoryBox->setSingleStep(128);
+
     /* Default values */
     m_CacheBox->setValue(1);
     m_ThreadsBox->setValue(maxThreads * 0.5);
+    m_TextureMemoryBox->setValue(1024);
 }
 
 size_t CachePreferences::TotalMemory()
@@ -5,6 +5,7 @@
 #define _VOID_CACHE_PREFERENCES_H
 
 /* Qt */
+#include <QCheckBox>
 #include <QLabel>
 #include <QLayout>
 #include <QSpinBox>
@@ -33,6 +34,14 @@ private: /* Members */
     QLabel* m_CacheLabel;
     QSpinBox* m_CacheBox;
 
+    /* Automatic Memory */
+    QLabel* m_AutoMemoryLabel;
+    QCheckBox* m_AutoMemoryCheck;
+
+    /* GPU Texture Memory */
+    QLabel* m_TextureMemoryLabel;
+    QSpinBox* m_TextureMemoryBox;
+
     /* Threads */
     QLabel* m_ThreadsDescription;
     QLabel* m_ThreadsLabel;
@@ -19,7 +19,9 @@ namespace Settings
     constexpr auto ColorStyle = "theme/colorStyle";
     constexpr auto MediaViewType = "mediaView/viewType";
     constexpr auto CacheMemory = "cache/memory";
+    constexpr auto CacheAutoMemory = "cache/autoMemory";
     constexpr auto CacheThreads = "cache/threads";
+    constexpr auto CacheTextureMemory = "cache/textureMemory";
     constexpr auto RecentProjects = "recents/projects";
     constexpr auto DontShowStartup = "startup/dontShowPopup";
     constexpr auto LastBrowsedLocation = "recents/browsed";
@@ -56,7 +58,10 @@ public:
     inline int GetUndoQueueSizeHint() const { return GetSetting(Settings::UndoQueueSize).toInt(); }
     inline int GetMediaViewType() const { return GetSetting(Settings::MediaViewType).toInt(); }
     inline unsigned long long GetCacheMemory() const { return GetSetting(Settings::CacheMemory).toULongLong(); }
+    inline bool GetCacheAutoMemory() const { return GetSetting(Settings::CacheAutoMemory).toBool(); }
     inline unsigned int GetCacheThreads() const { return GetSetting(Settings::CacheThreads).toUInt(); }
+    /* Memory (MB) for the textures kept resident on the GPU, defaults to 1 GB */
+    inline unsigned long long GetCacheTextureMemory() const { return m_Settings.value(Settings::CacheTextureMemory, 1024).toULongLong(); }
     inline int GetColorStyle() const { return GetSetting(Settings::ColorStyle).toInt(); }
     inline bool ShowStartup() const { return !GetSetting(Settings::DontShowStartup).toBool(); }
     inline QString LastBrowsed() const { return GetSetting(Settings::LastBrowsedLocation).toString(); }
@@ -268,7 +268,6 @@ void Timeline::SetRange(const int min, const int max)
 
 	/* Update timeslider range */
 	m_Timeslider->setRange(min, max);
-	m_Timeslider->m_CachedFrames.reserve(max - min + 1);
 
 	/* Update internal range */
 	Timekeeper::Instance().SetRange(min, max);
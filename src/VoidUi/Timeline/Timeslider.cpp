@@ -176,11 +176,9 @@ void Timeslider::paintEvent(QPaintEvent* event)
 		);
 	}
 
-	for (int frame : m_CachedFrames)
-	{
-		painter.setPen(QPen(SL_CACHE_COLOR, 3));
-		painter.drawLine((frame - minimum()) * uwidth, 0, (frame - minimum()) * uwidth + uwidth, 0);
-	}
+	painter.setPen(QPen(SL_CACHE_COLOR, 3));
+	for (const auto& [start, end] : m_CachedFrames)
+		painter.drawLine((start - minimum()) * uwidth, 0, (end - minimum()) * uwidth + uwidth, 0);
 
 	for (int frame : m_AnnotatedFrames)
 	{
@@ -272,7 +270,7 @@ void Timeslider::ResetEndFrame()
 
 void Timeslider::AddCacheFrame(int frame)
 {
-	m_CachedFrames.push_back(frame);
+	m_CachedFrames.Add(frame);
 
 	/* Repaint after a frame has been cached to redraw the cache line */
 	update();
@@ -280,16 +278,14 @@ void Timeslider::AddCacheFrame(int frame)
 
 void Timeslider::RemoveCachedFrame(int frame)
 {
-	std::vector<int>::iterator it = std::find(m_CachedFrames.begin(), m_CachedFrames.end(), frame);
-
 	/*
-	 * If the value is not present in cached frames already
-	 * Add it to the set
+	 * If the value is present in cached frames
+	 * Remove it from the spans
 	 */
-	if (it != m_CachedFrames.end())
+	if (m_CachedFrames.Contains(frame))
 	{
-		m_CachedFrames.erase(it);
-		/* Repaint after a frame has been cached to redraw the cache line */
+		m_CachedFrames.Remove(frame);
+		/* Repaint after a frame has been uncached to redraw the cache line */
 		update();
 	}
 }
@@ -297,9 +293,7 @@ void Timeslider::RemoveCachedFrame(int frame)
 void Timeslider::ClearCachedFrames()
 {
 	/* Clears the contents of the cached frames */
-	m_CachedFrames.clear();
-	m_CachedFrames.resize(0);
-	m_CachedFrames.shrink_to_fit();
+	m_CachedFrames.Clear();
 
 	/* Repaint after the cache frames have been cleared */
 	update();
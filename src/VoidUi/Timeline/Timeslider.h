@@ -13,6 +13,7 @@
 
 /* Internal */
 #include "QDefinition.h"
+#include "VoidCore/CacheIndex.h"
 
 VOID_NAMESPACE_OPEN
 
@@ -79,18 +80,18 @@ private: /* Methods */
 	}
 
 	/* Returns whether the requested frame is cached? */
-	inline bool Cached(int frame) const
-	{
-		return std::find(m_CachedFrames.begin(), m_CachedFrames.end(), frame) != m_CachedFrames.end();
-	}
+	inline bool Cached(int frame) const { return m_CachedFrames.Contains(frame); }
 
 private: /* Members */
 	bool m_Focussed;
 	int m_HovXPos;
 	int m_HoveredFrame;
 
-	/* Stores any frame that have been marked as Cached for the timeslider */
-	std::vector<int> m_CachedFrames;
+	/**
+	 * Stores any frame that have been marked as Cached for the timeslider
+	 * The frames are stored as spans of contiguous frames, which get drawn as a single line each
+	 */
+	FrameSpans m_CachedFrames;
 	/* Stores any frame that has been annotated */
 	std::vector<int> m_AnnotatedFrames;
 
@@ -6,6 +6,7 @@
 
 /* STD */
 #include <memory>
+#include <string>
 #include <vector>
 
 /* Internal */
@@ -15,13 +16,99 @@
 
 VOID_NAMESPACE_OPEN
 
+/**
+ * @brief An affine transformation of the normalized (0 - 1) coordinates of an image.
+ * Maps the coordinate of a pixel in the output to where it gets sampled from in the input, as a row major 2x3
+ *      u' = m[0] * u + m[1] * v + m[2]
+ *      v' = m[3] * u + m[4] * v + m[5]
+ */
+struct TextureTransform
+{
+    float m[6] = {1.f, 0.f, 0.f, 0.f, 1.f, 0.f};
+
+    TextureTransform() = default;
+    TextureTransform(float a, float b, float c, float d, float e, float f) : m{a, b, c, d, e, f} {}
+
+    /**
+     * @brief Returns the transform which first applies other and then this on a coordinate.
+     */
+    inline TextureTransform operator*(const TextureTransform& other) const
+    {
+        const float* o = other.m;
+        return TextureTransform(
+            m[0] * o[0] + m[1] * o[3], m[0] * o[1] + m[1] * o[4], m[0] * o[2] + m[1] * o[5] + m[2],
+            m[3] * o[0] + m[4] * o[3], m[3] * o[1] + m[4] * o[4], m[3] * o[2] + m[4] * o[5] + m[5]
+        );
+    }
+
+    inline bool Identity() const
+    {
+        return m[0] == 1.f && m[1] == 0.f && m[2] == 0.f && m[3] == 0.f && m[4] == 1.f && m[5] == 0.f;
+    }
+};
+
 class VOID_API ImageOp
 {
 public:
+    /**
+     * @brief Describes what the operator works on.
+     * Color operators transform the pixel values and provide a shader snippet, Coordinate operators are geometric
+     * i.e. they only move pixels around and are described by a TextureTransform (Geometry) instead, which the
+     * renderer applies on the texture coordinates and the processor in a final pass over the image.
+     */
+    enum class ShaderStage
+    {
+        Color,
+        Coordinate
+    };
+
     virtual ~ImageOp();
 
     Param* GetParam(const std::string& name);
-    virtual bool Evaluate(ImageRow& row) = 0;
+
+    /**
+     * @brief Evaluates the operator on a row of the image.
+     *
+     * @param row The row of pixels to be modified in place.
+     * @param params Values of the params to evaluate with, the same snapshot is used for all rows of a frame.
+     * @return bool true if the row was evaluated.
+     */
+    virtual bool Evaluate(ImageRow& row, const ParamSnapshot& params) = 0;
+
+    /**
+     * @brief Takes a snapshot of the current values of the params.
+     */
+    ParamSnapshot Snapshot() const;
+
+    /**
+     * @brief GLSL implementation of the operator allowing it to be applied while drawing the image.
+     * The snippet defines a function with the provided name, vec4 name(vec4 color). The params (apart from strings)
+     * are available as uniforms named <name>_<param name> and the number of channels in the image as the int
+     * uniform channels. The result is expected to match what Evaluate produces.
+     * Operators providing the snippet override Drawable to return true as well.
+     *
+     * @param name Name of the function to be defined.
+     * @return std::string The snippet, empty if the operator can only be evaluated on the CPU.
+     */
+    virtual std::string Shader(const std::string&) const { return std::string(); }
+    virtual ShaderStage Stage() const { return ShaderStage::Color; }
+
+    /**
+     * @brief Transformation of the image coordinates for the geometric (Coordinate stage) operators.
+     *
+     * @param params Values of the params.
+     * @return TextureTransform Where each pixel of the output gets sampled from, identity for Color operators.
+     */
+    virtual TextureTransform Geometry(const ParamSnapshot&) const { return TextureTransform(); }
+
+    inline bool Geometric() const { return Stage() == ShaderStage::Coordinate; }
+
+    /**
+     * @brief Returns whether the operator can be applied while drawing the image instead of being evaluated.
+     * This gets queried on every evaluation, so is answered without building the Shader.
+     * Geometric operators are always drawable, the ones which provide a Shader override this.
+     */
+    virtual bool Drawable() const { return Geometric(); }
 
     const std::vector<Param*>& Params() const { return m_Params; }
 
@@ -5,9 +5,12 @@
 #define _PARAMETERS_H
 
 /* STD */
+#include <cstddef>
+#include <cstring>
 #include <string>
 #include <optional>
 #include <variant>
+#include <vector>
 
 /* Internal */
 #include "Definition.h"
@@ -133,6 +136,80 @@ struct VOID_API Param
     std::string GetString() const;
 };
 
+/**
+ * @brief An immutable copy of the values of the params of an operator, taken once for the evaluation of a frame.
+ * The values are plain data so they can be read from the hot loops without any lookup or locking and are unaffected
+ * by the params being edited while the frame is being evaluated.
+ *
+ * Values are indexed in the order the params were added on the operator (there's one for each of the params),
+ * the values of the string params are kept aside, in order, as those aren't read while evaluating.
+ *
+ * The values of operators with up to MAX_INLINE_VALUES params are held inline, so a snapshot is taken without
+ * any allocation, only the operators with more (or string) params spill onto the vectors.
+ */
+struct ParamSnapshot
+{
+    union Value
+    {
+        int i;
+        float f;
+        bool b;
+    };
+
+    static constexpr std::size_t MAX_INLINE_VALUES = 16;
+
+    Value values[MAX_INLINE_VALUES];
+
+    /* Values of the params past the inline ones */
+    std::vector<Value> overflow;
+    std::vector<std::string> strings;
+
+    /* Number of values in the snapshot */
+    std::size_t count = {0};
+
+    /* Hash of the operator and all of its values, the same values produce the same hash */
+    std::size_t hash = {0};
+
+    inline void Push(Value value)
+    {
+        if (count < MAX_INLINE_VALUES)
+            values[count] = value;
+        else
+            overflow.push_back(value);
+
+        ++count;
+    }
+
+    inline const Value& At(std::size_t index) const
+    {
+        return index < MAX_INLINE_VALUES ? values[index] : overflow[index - MAX_INLINE_VALUES];
+    }
+
+    inline int Int(std::size_t index) const { return At(index).i; }
+    inline float Float(std::size_t index) const { return At(index).f; }
+    inline bool Bool(std::size_t index) const { return At(index).b; }
+
+    /**
+     * Snapshots are equal when all of their values are, the hash is only the quick way out
+     * the values are compared bitwise, the unused bytes of a value are always zeroed when taking the snapshot
+     */
+    inline bool operator==(const ParamSnapshot& other) const
+    {
+        if (hash != other.hash || count != other.count || strings != other.strings)
+            return false;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (std::memcmp(&At(i), &other.At(i), sizeof(Value)))
+                return false;
+        }
+
+        return true;
+    }
+
+    inline bool operator!=(const ParamSnapshot& other) const { return !(*this == other); }
+};
+
 VOID_NAMESPACE_CLOSE
 
 #endif // _PARAMETERS_H
@@ -1,11 +1,26 @@
 // Copyright (c) 2025 waaake
 // Licensed under the MIT License
 
+#ifndef _VOID_ROW_H
+#define _VOID_ROW_H
+
 /* Internal */
 #include "Definition.h"
 
 VOID_NAMESPACE_OPEN
 
+/**
+ * @brief Underlying type of each channel of the pixels.
+ * Integer types are normalized i.e. 0 - 255 for Uint8 and 0 - 65535 for Uint16 map to 0 - 1.
+ */
+enum class PixelType
+{
+    Uint8,
+    Uint16,
+    Half,
+    Float
+};
+
 /**
  * @brief An ImageRow is what it looks like, a row 'of data'
  * The data in this case it represents is image pixels, an image is just a collection of
@@ -31,8 +46,9 @@ struct ImageRow
     std::size_t width;
     std::size_t channels;
     std::size_t stride;
+    PixelType type;
 
-    ImageRow() : buffer(nullptr), width(0), channels(0), stride(0) {}
+    ImageRow() : buffer(nullptr), width(0), channels(0), stride(0), type(PixelType::Float) {}
 
     /**
      * @brief Construct an ImageRow of Pixels.
@@ -43,13 +59,36 @@ struct ImageRow
      * @param channels Number of channels in the image (size of each pixel).
      * @param stride Stride represents the underlying data type size, since the buffer is a void* this represents
      *      how many bytes to offset to move to the next channel in the same pixel.
+     *      The type is inferred from it, 2 bytes are taken as Uint16, the typed constructor is needed for Half.
      */
     ImageRow(void* buffer, std::size_t row, std::size_t width, std::size_t channels, std::size_t stride)
-        : width(width), channels(channels), stride(stride)
+        : ImageRow(buffer, row, width, channels, stride == 1 ? PixelType::Uint8 : stride == 2 ? PixelType::Uint16 : PixelType::Float)
+    {
+    }
+
+    /**
+     * @brief Construct an ImageRow of Pixels of the given type.
+     *
+     * @param buffer The completed data from the image.
+     * @param row Row being requested. e.g. row 1, row 5...
+     * @param width Width of the image.
+     * @param channels Number of channels in the image (size of each pixel).
+     * @param type Type of each of the channels, the stride is based on the size of the type.
+     */
+    ImageRow(void* buffer, std::size_t row, std::size_t width, std::size_t channels, PixelType type)
+        : width(width), channels(channels), stride(Size(type)), type(type)
     {
         this->buffer = static_cast<std::byte*>(buffer) + row * width * channels * stride;
     }
 
+    /**
+     * @brief Returns the size in bytes of a channel of the given type.
+     */
+    static constexpr std::size_t Size(PixelType type)
+    {
+        return (type == PixelType::Uint8) ? 1 : (type == PixelType::Float) ? 4 : 2;
+    }
+
     /**
      * @brief Each pixel is a collection of n channels, and the channels are defined in the image
      * returns the pointer to the start of the pixel which can be iterated upon (max: channel count).
@@ -68,3 +107,5 @@ struct ImageRow
 };
 
 VOID_NAMESPACE_CLOSE
+
+#endif // _VOID_ROW_H